@@ -0,0 +1,565 @@
+/**
+* Copyright (c) Microblink Ltd. All rights reserved.
+*
+* ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+* OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+* WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+* UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+* THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+* REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+*/
+
+/*
+ * photopay-bench - measures throughput and latency of payment barcode recognition on a corpus of images.
+ *
+ * usage: photopay-bench [options] <directory|manifest>
+ *
+ * Images are taken from the given directory (.jpg, .jpeg, .png, .bmp, .tif, .tiff), or from a manifest file that
+ * lists one image path per line, relative to the manifest. Empty lines and lines starting with '#' are ignored.
+ * All images are decoded before measuring, so that only recognition is measured.
+ *
+ * For every combination of thread count, slowerThoroughScan, uncertainDecoding and ROI, each thread gets its own
+ * recognizer runner, which is warmed up before the measurement starts, and the threads then recognize the corpus
+ * together. The report is printed as JSON, with one entry per combination.
+ *
+ * options:
+ *   --threads <n,n,...>        thread counts to sweep, 1,2,4 by default
+ *   --thorough <on|off|both>   values of slowerThoroughScan to sweep, both by default
+ *   --uncertain <on|off|both>  values of uncertainDecoding to sweep, both by default
+ *   --roi <x,y,width,height>   relative region of interest, swept together with the whole image
+ *   --warmup <n>               images recognized by each runner before measuring, 5 by default
+ *   --iterations <n>           passes over the corpus per combination, 1 by default
+ *   --output <file>            file that receives the report, standard output by default
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <BenchmarkRunner.h>
+#include <ImageCorpus.h>
+#include <Platform.h>
+
+#include <RecognizerApi.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_THREADS     64
+
+/* all configurations of the sweep, in the order in which they are measured */
+typedef struct BenchOptions
+{
+    int         threadCounts[ MAX_THREADS ];
+    int         numThreadCounts;
+    MBBool      thoroughValues[ 2 ];
+    int         numThoroughValues;
+    MBBool      uncertainValues[ 2 ];
+    int         numUncertainValues;
+    MBRectangle roi;
+    int         hasRoi;
+    int         warmup;
+    int         iterations;
+    char const * input;
+    char const * output;
+} BenchOptions;
+
+/* work shared by the threads of a single measurement */
+typedef struct BenchJob
+{
+    MBImageCorpus const * corpus;
+    size_t              numRecognitions;
+    size_t              next;
+    MBPlatformMutex     mutex;
+    uint64_t          * latenciesNs;
+    MBBool            * successes;
+} BenchJob;
+
+typedef struct BenchWorker
+{
+    BenchJob          * job;
+    MBBenchmarkRunner * runner;
+    MBPlatformThread    thread;
+} BenchWorker;
+
+typedef struct BenchMeasurement
+{
+    uint64_t wallNs;
+    size_t   numRecognitions;
+    size_t   numSuccesses;
+    uint64_t meanNs;
+    uint64_t p50Ns;
+    uint64_t p95Ns;
+    uint64_t p99Ns;
+    uint64_t maxNs;
+    uint64_t peakRssBytes;
+} BenchMeasurement;
+
+static void benchWorkerRun( void * argument )
+{
+    BenchWorker * worker = ( BenchWorker * ) argument;
+    BenchJob    * job    = worker->job;
+
+    for ( ;; )
+    {
+        size_t                  index;
+        uint64_t                start;
+        MBRecognizerResultState state;
+
+        platformMutexLock( &job->mutex );
+        index = job->next++;
+        platformMutexUnlock( &job->mutex );
+
+        if ( index >= job->numRecognitions )
+        {
+            break;
+        }
+
+        start = platformMonotonicNanoseconds();
+        state = recognizerRunnerRecognizeFromImage( worker->runner->recognizerRunner, job->corpus->entries[ index % job->corpus->count ].image, MB_FALSE, NULL );
+
+        job->latenciesNs[ index ] = platformMonotonicNanoseconds() - start;
+        job->successes  [ index ] = state == MB_RECOGNIZER_RESULT_STATE_VALID ? MB_TRUE : MB_FALSE;
+    }
+}
+
+static int compareLatencies( void const * a, void const * b )
+{
+    uint64_t first  = *( uint64_t const * ) a;
+    uint64_t second = *( uint64_t const * ) b;
+    return first < second ? -1 : first > second;
+}
+
+/* nearest-rank percentile of sorted latencies */
+static uint64_t percentile( uint64_t const * sortedNs, size_t count, unsigned percent )
+{
+    size_t rank = ( count * percent + 99 ) / 100;
+    return sortedNs[ rank > 0 ? rank - 1 : 0 ];
+}
+
+static MBRecognizerErrorStatus benchMeasure
+(
+    BenchMeasurement   * measurement,
+    MBImageCorpus const  * corpus,
+    BenchOptions const * options,
+    int                  numThreads,
+    MBBool               slowerThoroughScan,
+    MBBool               uncertainDecoding,
+    MBRectangle const  * roi
+)
+{
+    MBBenchmarkRunner       runners[ MAX_THREADS ];
+    BenchWorker             workers[ MAX_THREADS ];
+    BenchJob                job;
+    MBRecognizerErrorStatus status     = MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+    int                     numRunners = 0;
+    int                     numStarted = 0;
+    uint64_t                start;
+    uint64_t                totalNs    = 0;
+    size_t                  i;
+    int                     t;
+
+    memset( measurement, 0, sizeof( BenchMeasurement ) );
+    memset( &job, 0, sizeof( BenchJob ) );
+
+    job.corpus          = corpus;
+    job.numRecognitions = corpus->count * ( size_t ) options->iterations;
+    job.latenciesNs     = ( uint64_t * ) malloc( job.numRecognitions * sizeof( uint64_t ) );
+    job.successes       = ( MBBool   * ) malloc( job.numRecognitions * sizeof( MBBool ) );
+    if ( job.latenciesNs == NULL || job.successes == NULL )
+    {
+        free( job.latenciesNs );
+        free( job.successes );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+    platformMutexInit( &job.mutex );
+
+    for ( ; numRunners < numThreads; ++numRunners )
+    {
+        status = benchmarkRunnerCreate( &runners[ numRunners ], slowerThoroughScan, uncertainDecoding, roi );
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            break;
+        }
+        benchmarkRunnerWarmUp( &runners[ numRunners ], corpus, ( size_t ) options->warmup );
+    }
+
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        start = platformMonotonicNanoseconds();
+        for ( ; numStarted < numThreads; ++numStarted )
+        {
+            workers[ numStarted ].job    = &job;
+            workers[ numStarted ].runner = &runners[ numStarted ];
+            if ( !platformThreadCreate( &workers[ numStarted ].thread, benchWorkerRun, &workers[ numStarted ] ) )
+            {
+                status = MB_RECOGNIZER_ERROR_STATUS_FAIL;
+                break;
+            }
+        }
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            /* measurement is discarded, so threads that were started are stopped as soon as possible */
+            platformMutexLock( &job.mutex );
+            job.next = job.numRecognitions;
+            platformMutexUnlock( &job.mutex );
+        }
+        for ( t = 0; t < numStarted; ++t )
+        {
+            platformThreadJoin( &workers[ t ].thread );
+        }
+        measurement->wallNs = platformMonotonicNanoseconds() - start;
+    }
+
+    for ( t = 0; t < numRunners; ++t )
+    {
+        benchmarkRunnerDelete( &runners[ t ] );
+    }
+
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        measurement->numRecognitions = job.numRecognitions;
+        for ( i = 0; i < job.numRecognitions; ++i )
+        {
+            totalNs                    += job.latenciesNs[ i ];
+            measurement->numSuccesses  += job.successes[ i ] ? 1 : 0;
+        }
+
+        qsort( job.latenciesNs, job.numRecognitions, sizeof( uint64_t ), compareLatencies );
+        measurement->meanNs       = totalNs / job.numRecognitions;
+        measurement->p50Ns        = percentile( job.latenciesNs, job.numRecognitions, 50 );
+        measurement->p95Ns        = percentile( job.latenciesNs, job.numRecognitions, 95 );
+        measurement->p99Ns        = percentile( job.latenciesNs, job.numRecognitions, 99 );
+        measurement->maxNs        = job.latenciesNs[ job.numRecognitions - 1 ];
+        measurement->peakRssBytes = platformPeakRssBytes();
+    }
+
+    platformMutexDestroy( &job.mutex );
+    free( job.latenciesNs );
+    free( job.successes );
+
+    return status;
+}
+
+static double milliseconds( uint64_t ns )
+{
+    return ( double ) ns / 1e6;
+}
+
+static void printMeasurement
+(
+    FILE                   * output,
+    BenchMeasurement const * measurement,
+    int                      numThreads,
+    MBBool                   slowerThoroughScan,
+    MBBool                   uncertainDecoding,
+    MBRectangle const      * roi
+)
+{
+    fprintf( output, "    {\n" );
+    fprintf( output, "      \"threads\": %d,\n", numThreads );
+    fprintf( output, "      \"slowerThoroughScan\": %s,\n", slowerThoroughScan ? "true" : "false" );
+    fprintf( output, "      \"uncertainDecoding\": %s,\n", uncertainDecoding ? "true" : "false" );
+    if ( roi != NULL )
+    {
+        fprintf( output, "      \"roi\": { \"x\": %g, \"y\": %g, \"width\": %g, \"height\": %g },\n", roi->x, roi->y, roi->width, roi->height );
+    }
+    else
+    {
+        fprintf( output, "      \"roi\": null,\n" );
+    }
+    fprintf( output, "      \"recognitions\": %lu,\n", ( unsigned long ) measurement->numRecognitions );
+    fprintf( output, "      \"successRate\": %.4f,\n", ( double ) measurement->numSuccesses / ( double ) measurement->numRecognitions );
+    fprintf( output, "      \"imagesPerSecond\": %.2f,\n", ( double ) measurement->numRecognitions * 1e9 / ( double ) ( measurement->wallNs > 0 ? measurement->wallNs : 1 ) );
+    fprintf( output, "      \"latencyMs\": { \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+             milliseconds( measurement->meanNs ), milliseconds( measurement->p50Ns ), milliseconds( measurement->p95Ns ),
+             milliseconds( measurement->p99Ns ), milliseconds( measurement->maxNs ) );
+    fprintf( output, "      \"peakRssBytes\": %.0f\n", ( double ) measurement->peakRssBytes );
+    fprintf( output, "    }" );
+}
+
+static void printUsage( char const * program )
+{
+    printf( "usage %s [options] <directory|manifest>\n", program );
+    printf( "  --threads <n,n,...>        thread counts to sweep, 1,2,4 by default\n" );
+    printf( "  --thorough <on|off|both>   values of slowerThoroughScan to sweep, both by default\n" );
+    printf( "  --uncertain <on|off|both>  values of uncertainDecoding to sweep, both by default\n" );
+    printf( "  --roi <x,y,width,height>   relative region of interest, swept together with the whole image\n" );
+    printf( "  --warmup <n>               images recognized by each runner before measuring, 5 by default\n" );
+    printf( "  --iterations <n>           passes over the corpus per combination, 1 by default\n" );
+    printf( "  --output <file>            file that receives the report, standard output by default\n" );
+}
+
+static int parseSwitch( MBBool * values, int * numValues, char const * argument )
+{
+    if ( strcmp( argument, "on" ) == 0 )
+    {
+        values[ 0 ] = MB_TRUE;
+        *numValues  = 1;
+    }
+    else if ( strcmp( argument, "off" ) == 0 )
+    {
+        values[ 0 ] = MB_FALSE;
+        *numValues  = 1;
+    }
+    else if ( strcmp( argument, "both" ) == 0 )
+    {
+        /* SDK default first */
+        values[ 0 ] = MB_TRUE;
+        values[ 1 ] = MB_FALSE;
+        *numValues  = 2;
+    }
+    else
+    {
+        return 0;
+    }
+    return 1;
+}
+
+static int parsePositive( int * value, char const * argument, int minimum, int maximum )
+{
+    char * end;
+    long   parsed = strtol( argument, &end, 10 );
+
+    if ( end == argument || *end != '\0' || parsed < minimum || parsed > maximum )
+    {
+        return 0;
+    }
+    *value = ( int ) parsed;
+    return 1;
+}
+
+static int parseThreadCounts( BenchOptions * options, char const * argument )
+{
+    char const * position = argument;
+
+    options->numThreadCounts = 0;
+    for ( ;; )
+    {
+        char * end;
+        long   count = strtol( position, &end, 10 );
+
+        if ( end == position || count < 1 || count > MAX_THREADS || options->numThreadCounts == MAX_THREADS )
+        {
+            return 0;
+        }
+        options->threadCounts[ options->numThreadCounts++ ] = ( int ) count;
+
+        if ( *end == '\0' )
+        {
+            return 1;
+        }
+        if ( *end != ',' )
+        {
+            return 0;
+        }
+        position = end + 1;
+    }
+}
+
+static int parseRoi( MBRectangle * roi, char const * argument )
+{
+    float        values[ 4 ];
+    char const * position = argument;
+    int          i;
+
+    for ( i = 0; i < 4; ++i )
+    {
+        char * end;
+
+        values[ i ] = ( float ) strtod( position, &end );
+        if ( end == position || values[ i ] < 0.f || values[ i ] > 1.f || *end != ( i < 3 ? ',' : '\0' ) )
+        {
+            return 0;
+        }
+        position = end + 1;
+    }
+
+    roi->x      = values[ 0 ];
+    roi->y      = values[ 1 ];
+    roi->width  = values[ 2 ];
+    roi->height = values[ 3 ];
+
+    return roi->width > 0.f && roi->height > 0.f && roi->x + roi->width <= 1.f && roi->y + roi->height <= 1.f;
+}
+
+static int parseOptions( BenchOptions * options, int argc, char * argv[] )
+{
+    int i;
+
+    memset( options, 0, sizeof( BenchOptions ) );
+    options->threadCounts[ 0 ] = 1;
+    options->threadCounts[ 1 ] = 2;
+    options->threadCounts[ 2 ] = 4;
+    options->numThreadCounts   = 3;
+    parseSwitch( options->thoroughValues, &options->numThoroughValues, "both" );
+    parseSwitch( options->uncertainValues, &options->numUncertainValues, "both" );
+    options->warmup     = 5;
+    options->iterations = 1;
+
+    for ( i = 1; i < argc; ++i )
+    {
+        char const * option   = argv[ i ];
+        char const * argument = i + 1 < argc ? argv[ i + 1 ] : NULL;
+        int          valid;
+
+        if ( option[ 0 ] != '-' )
+        {
+            if ( options->input != NULL )
+            {
+                return 0;
+            }
+            options->input = option;
+            continue;
+        }
+        if ( argument == NULL )
+        {
+            return 0;
+        }
+
+        if ( strcmp( option, "--threads" ) == 0 )
+        {
+            valid = parseThreadCounts( options, argument );
+        }
+        else if ( strcmp( option, "--thorough" ) == 0 )
+        {
+            valid = parseSwitch( options->thoroughValues, &options->numThoroughValues, argument );
+        }
+        else if ( strcmp( option, "--uncertain" ) == 0 )
+        {
+            valid = parseSwitch( options->uncertainValues, &options->numUncertainValues, argument );
+        }
+        else if ( strcmp( option, "--roi" ) == 0 )
+        {
+            valid = options->hasRoi = parseRoi( &options->roi, argument );
+        }
+        else if ( strcmp( option, "--warmup" ) == 0 )
+        {
+            valid = parsePositive( &options->warmup, argument, 0, 1000000 );
+        }
+        else if ( strcmp( option, "--iterations" ) == 0 )
+        {
+            valid = parsePositive( &options->iterations, argument, 1, 1000000 );
+        }
+        else if ( strcmp( option, "--output" ) == 0 )
+        {
+            options->output = argument;
+            valid           = 1;
+        }
+        else
+        {
+            valid = 0;
+        }
+
+        if ( !valid )
+        {
+            fprintf( stderr, "Invalid option %s %s\n", option, argument );
+            return 0;
+        }
+        ++i;
+    }
+
+    return options->input != NULL;
+}
+
+int main( int argc, char * argv[] )
+{
+    BenchOptions            options;
+    MBImageCorpus           corpus;
+    MBRecognizerErrorStatus errorStatus;
+    FILE                  * output;
+    int                     numRois;
+    int                     numMeasurements = 0;
+    int                     threadIndex;
+    int                     thoroughIndex;
+    int                     uncertainIndex;
+    int                     roiIndex;
+
+    if ( !parseOptions( &options, argc, argv ) )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    errorStatus = benchmarkUnlock( "PhotoPayBench" );
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to unlock! Reason: %s\n", recognizerErrorToString( errorStatus ) );
+        return EXIT_FAILURE;
+    }
+
+    memset( &corpus, 0, sizeof( MBImageCorpus ) );
+    errorStatus = imageCorpusLoad( &corpus, options.input, benchmarkReportLoadFailure, NULL );
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to read image list from '%s'. Reason: %s\n", options.input, recognizerErrorToString( errorStatus ) );
+    }
+    else if ( corpus.count == 0 )
+    {
+        fprintf( stderr, "No images found in '%s'\n", options.input );
+    }
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS || corpus.count == 0 )
+    {
+        imageCorpusFree( &corpus );
+        return EXIT_FAILURE;
+    }
+
+    output = options.output != NULL ? platformOpenFile( options.output, "w" ) : stdout;
+    if ( output == NULL )
+    {
+        fprintf( stderr, "Failed to open '%s' for writing\n", options.output );
+        imageCorpusFree( &corpus );
+        return EXIT_FAILURE;
+    }
+
+    fprintf( output, "{\n" );
+    fprintf( output, "  \"images\": %lu,\n", ( unsigned long ) corpus.count );
+    fprintf( output, "  \"warmup\": %d,\n", options.warmup );
+    fprintf( output, "  \"iterations\": %d,\n", options.iterations );
+    fprintf( output, "  \"runs\": [\n" );
+
+    numRois = options.hasRoi ? 2 : 1;
+
+    /* thread count varies slowest, so that the process peak RSS of each run reflects the largest thread count so far */
+    for ( threadIndex = 0; threadIndex < options.numThreadCounts; ++threadIndex )
+    {
+        for ( thoroughIndex = 0; thoroughIndex < options.numThoroughValues; ++thoroughIndex )
+        {
+            for ( uncertainIndex = 0; uncertainIndex < options.numUncertainValues; ++uncertainIndex )
+            {
+                for ( roiIndex = 0; roiIndex < numRois; ++roiIndex )
+                {
+                    BenchMeasurement    measurement;
+                    MBRectangle const * roi = roiIndex == 1 ? &options.roi : NULL;
+
+                    errorStatus = benchMeasure( &measurement, &corpus, &options, options.threadCounts[ threadIndex ],
+                                                options.thoroughValues[ thoroughIndex ], options.uncertainValues[ uncertainIndex ], roi );
+                    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+                    {
+                        fprintf( stderr, "Failed to measure %d threads. Reason: %s\n", options.threadCounts[ threadIndex ], recognizerErrorToString( errorStatus ) );
+                        continue;
+                    }
+
+                    if ( numMeasurements++ > 0 )
+                    {
+                        fprintf( output, ",\n" );
+                    }
+                    printMeasurement( output, &measurement, options.threadCounts[ threadIndex ],
+                                      options.thoroughValues[ thoroughIndex ], options.uncertainValues[ uncertainIndex ], roi );
+                    fflush( output );
+                }
+            }
+        }
+    }
+
+    fprintf( output, "\n  ]\n}\n" );
+
+    if ( output != stdout )
+    {
+        fclose( output );
+    }
+    imageCorpusFree( &corpus );
+
+    return numMeasurements > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,1313 @@
+/**
+* Copyright (c) Microblink Ltd. All rights reserved.
+*
+* ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+* OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+* WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+* UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+* THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+* REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+*/
+
+/*
+ * photopay-corpusgen - generates a reproducible corpus of synthetic payment slip images for benchmarks and regression
+ * tests, without any personal data or third party images.
+ *
+ * usage: photopay-corpusgen [options] <output directory>
+ *
+ * Every image contains a random payment with a payload in HUB3 data format, encoded as PDF417 or QR code and printed
+ * on a slip-like form which also shows the payment fields as text. The slip is then photographed: rotated, tilted in
+ * perspective, blurred and covered with sensor noise. Each degradation is drawn uniformly from the given range, which
+ * is either a single value or min:max. Images depend only on the seed and their index, so the first images of a larger
+ * corpus are the same as the images of a smaller one.
+ *
+ * HUB3 slips carry PDF417 symbols, so those are generated by default. PDF417 encoding needs the codeword pattern tables
+ * of ISO/IEC 15438, so it is done by an external encoder instead: the command is run with %s replaced by the path of the
+ * payload file, and must print one line per row of the symbol, with 4 modules per hexadecimal digit, most significant
+ * bit first and dark modules set, ignoring spaces. This is the output of zint --dump, and zint is used by default.
+ * Every row is printed 3 modules high. QR codes are encoded by QrCodeEncoder.h and need no external tool.
+ *
+ * For every image, slip-NNNNN.png (8 bit grayscale, stored without compression) and slip-NNNNN.txt with the exact
+ * payload are written. manifest.txt lists the images for photopay-bench, and parameters.tsv lists the barcode, QR code
+ * version (0 for PDF417) and degradations of every image, so that results can be broken down by them.
+ *
+ * options:
+ *   --count <n>                    number of images, 100 by default
+ *   --seed <n>                     seed of the corpus, 1 by default
+ *   --dpi <n>                      resolution at which the slip is printed, 200 by default
+ *   --barcode <pdf417|qr|mixed>    barcode printed on the slips, mixed alternates starting with PDF417, pdf417 by default
+ *   --pdf417-encoder <command>     command that encodes the payload file %s into PDF417, by default
+ *                                  zint --barcode=55 --binary --cols=9 --secure=4 --dump --input="%s"
+ *   --module <mm>                  size of barcode module, 0.4:0.6 mm by default
+ *   --error-correction <L|M|Q|H>   error correction level of QR codes, M by default
+ *   --rotation <degrees>           rotation of the slip, -10:10 by default
+ *   --perspective <fraction>       difference in scale between opposite edges of the slip, 0:0.15 by default
+ *   --blur <pixels>                standard deviation of Gaussian blur, 0:1.2 by default
+ *   --noise <levels>               standard deviation of Gaussian noise, in gray levels, 0:8 by default
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <CroatiaPaymentPayloadBuilder.h>
+#include <Platform.h>
+#include <QrCodeEncoder.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <errno.h>
+#   include <sys/stat.h>
+#endif
+
+#define MAX_PATH_LENGTH     1024
+#define MAX_COMMAND_LENGTH  4096
+#define PI                  3.14159265358979323846
+#define MM_PER_INCH         25.4
+
+/* dimensions of the slip, in millimetres */
+#define SLIP_WIDTH_MM       210.0
+#define SLIP_HEIGHT_MM      99.0
+
+#define PAPER_LEVEL         238
+#define FORM_LEVEL          150
+#define INK_LEVEL           35
+
+/* largest symbols, i.e. PDF417 with 90 rows of 30 data columns, and QR code version 40 */
+#define MAX_SYMBOL_WIDTH    1024
+#define MAX_SYMBOL_MODULES  ( 64 * 1024 )
+
+#define PDF417_ROW_HEIGHT   3
+#define PDF417_QUIET_ZONE   2
+#define QR_CODE_QUIET_ZONE  4
+
+#define DEFAULT_PDF417_ENCODER "zint --barcode=55 --binary --cols=9 --secure=4 --dump --input=\"%s\""
+
+typedef struct Range
+{
+    double minimum;
+    double maximum;
+} Range;
+
+typedef enum Barcode
+{
+    BARCODE_PDF417 = 0,
+    BARCODE_QR,
+    BARCODE_MIXED
+} Barcode;
+
+/* values of --barcode, in the order of Barcode */
+static char const * const barcodeNames[] = { "pdf417", "qr", "mixed" };
+
+typedef struct CorpusOptions
+{
+    int                     count;
+    unsigned long           seed;
+    int                     dpi;
+    Barcode                 barcode;
+    char const            * pdf417Encoder;
+    Range                   moduleMm;
+    MBQrCodeErrorCorrection errorCorrection;
+    Range                   rotationDegrees;
+    Range                   perspective;
+    Range                   blurSigma;
+    Range                   noiseSigma;
+    char const            * output;
+} CorpusOptions;
+
+typedef struct Random
+{
+    uint64_t state;
+} Random;
+
+typedef struct GrayImage
+{
+    int      width;
+    int      height;
+    MBByte * pixels;
+} GrayImage;
+
+/* modules of the printed barcode, rows x width in row-major order, 1 for dark modules */
+typedef struct Symbol
+{
+    char const * barcode;
+    int          version;
+    int          width;
+    int          rows;
+    int          rowHeight;
+    int          quietZone;
+    MBByte       modules[ MAX_SYMBOL_MODULES ];
+} Symbol;
+
+/* storage of the generated payment, referenced by MBCroatiaBarcodePaymentRecognizerResult */
+typedef struct SlipFields
+{
+    char payerName[ 31 ];
+    char payerAddress[ 28 ];
+    char recipientAddress[ 26 ];
+    char iban[ MB_CROATIA_IBAN_BUFFER_SIZE ];
+    char reference[ 23 ];
+    char description[ 48 ];
+    char amount[ 16 ];
+    MBCroatiaBarcodePaymentRecognizerResult result;
+} SlipFields;
+
+/* parameters of a single generated image */
+typedef struct SlipParameters
+{
+    double moduleMm;
+    double rotationDegrees;
+    double perspective;
+    double blurSigma;
+    double noiseSigma;
+} SlipParameters;
+
+static char const * const firstNames[] = { "Ivan", "Marko", "Ana", "Maja", "Petra", "Luka", "Josip", "Ivana", "Tomislav", "Katarina", "Nikola", "Marija", "Filip", "Lucija", "Mateo", "Sara" };
+static char const * const lastNames[]  = { "Horvat", "Kovacevic", "Babic", "Maric", "Juric", "Novak", "Kovacic", "Knezevic", "Vukovic", "Markovic", "Petrovic", "Matic", "Tomic", "Pavlovic", "Bozic", "Blazevic" };
+static char const * const streets[]    = { "Ilica", "Vukovarska", "Savska cesta", "Frankopanska", "Zagrebacka", "Riva", "Korzo", "Kralja Zvonimira", "Ulica grada Vukovara", "Trg slobode" };
+static char const * const cities[]     = { "10000 Zagreb", "21000 Split", "51000 Rijeka", "31000 Osijek", "23000 Zadar", "52100 Pula", "20000 Dubrovnik", "42000 Varazdin", "47000 Karlovac", "35000 Slavonski Brod" };
+static char const * const recipients[] = { "HEP ELEKTRA d.o.o.", "Hrvatski Telekom d.d.", "Vodoopskrba d.o.o.", "Gradska plinara d.o.o.", "Zagrebacki holding", "A1 Hrvatska d.o.o.", "Porezna uprava", "Grad Zagreb", "Hrvatske sume d.o.o.", "Studentski centar" };
+static char const * const bankCodes[]  = { "2340009", "2360000", "2484008", "2402006", "2330003", "2390001", "2500009", "2407000", "2412009", "2386002" };
+static char const * const purposes[]   = { "OTHR", "ELEC", "GASB", "WTER", "PHON", "TAXS", "RENT", "SUPP", "COST", "SALA" };
+
+#define PICK( random, array ) ( array[ randomInt( random, ( int ) ( sizeof( array ) / sizeof( array[ 0 ] ) ) ) ] )
+
+/* splitmix64, so that the corpus is the same on every platform */
+static uint64_t randomNext( Random * random )
+{
+    uint64_t z = ( random->state += 0x9E3779B97F4A7C15ull );
+
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    return z ^ ( z >> 31 );
+}
+
+static double randomUniform( Random * random )
+{
+    return ( double ) ( randomNext( random ) >> 11 ) / 9007199254740992.0;
+}
+
+static int randomInt( Random * random, int count )
+{
+    return ( int ) ( randomUniform( random ) * count );
+}
+
+static double randomInRange( Random * random, Range const * range )
+{
+    return range->minimum + ( range->maximum - range->minimum ) * randomUniform( random );
+}
+
+static double randomGaussian( Random * random )
+{
+    double u = randomUniform( random );
+    double v = randomUniform( random );
+
+    return sqrt( -2.0 * log( 1.0 - u ) ) * cos( 2.0 * PI * v );
+}
+
+static void randomDigits( Random * random, char * digits, int count )
+{
+    int i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        digits[ i ] = ( char ) ( '0' + randomInt( random, 10 ) );
+    }
+    digits[ count ] = '\0';
+}
+
+static void generatePayment( SlipFields * fields, Random * random )
+{
+    MBCroatiaBarcodePaymentRecognizerResult * result = &fields->result;
+    char                                      account[ 11 ];
+    char                                      part[ 8 ];
+    int                                       model;
+
+    memset( result, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+
+    /* payer is optional on slips paid at the counter */
+    if ( randomInt( random, 10 ) > 0 )
+    {
+        snprintf( fields->payerName, sizeof( fields->payerName ), "%s %s", PICK( random, firstNames ), PICK( random, lastNames ) );
+        snprintf( fields->payerAddress, sizeof( fields->payerAddress ), "%s %d", PICK( random, streets ), 1 + randomInt( random, 150 ) );
+        result->payerName            = fields->payerName;
+        result->payerAddress         = fields->payerAddress;
+        result->payerDetailedAddress = PICK( random, cities );
+    }
+
+    snprintf( fields->recipientAddress, sizeof( fields->recipientAddress ), "%s %d", PICK( random, streets ), 1 + randomInt( random, 150 ) );
+    result->recipientName            = PICK( random, recipients );
+    result->recipientAddress         = fields->recipientAddress;
+    result->recipientDetailedAddress = PICK( random, cities );
+
+    randomDigits( random, account, 10 );
+    croatiaIbanFromBankAccount( fields->iban, PICK( random, bankCodes ), account );
+    result->iban = fields->iban;
+
+    /* HR01 with three parts, HR00 with a single part, or HR99 without reference */
+    model = randomInt( random, 10 );
+    if ( model < 6 )
+    {
+        randomDigits( random, part, 7 );
+        snprintf( fields->reference, sizeof( fields->reference ), "%s-%04d-%d", part, randomInt( random, 10000 ), randomInt( random, 10 ) );
+        result->referenceModel = "HR01";
+    }
+    else if ( model < 9 )
+    {
+        randomDigits( random, fields->reference, 12 );
+        result->referenceModel = "HR00";
+    }
+    else
+    {
+        fields->reference[ 0 ] = '\0';
+        result->referenceModel = "HR99";
+    }
+    result->reference = fields->reference;
+
+    result->purposeCode = PICK( random, purposes );
+    snprintf( fields->description, sizeof( fields->description ), "Racun br. %d-%d/%d", 1 + randomInt( random, 99999 ), 1 + randomInt( random, 99 ), 2020 + randomInt( random, 7 ) );
+    result->paymentDescription = fields->description;
+
+    /* log-uniform between 1 and 10000 EUR, in cents */
+    result->amountEur = ( int ) ( 100.0 * exp( randomUniform( random ) * log( 10000.0 ) ) );
+    snprintf( fields->amount, sizeof( fields->amount ), "%d,%02d", result->amountEur / 100, result->amountEur % 100 );
+}
+
+static int imageCreate( GrayImage * image, int width, int height, MBByte level )
+{
+    image->width  = width;
+    image->height = height;
+    image->pixels = ( MBByte * ) malloc( ( size_t ) width * ( size_t ) height );
+    if ( image->pixels == NULL )
+    {
+        return 0;
+    }
+    memset( image->pixels, level, ( size_t ) width * ( size_t ) height );
+    return 1;
+}
+
+static void imageFree( GrayImage * image )
+{
+    free( image->pixels );
+    image->pixels = NULL;
+}
+
+/* fills rectangle given in pixels, clipped to the image */
+static void fillRect( GrayImage * image, double x0, double y0, double x1, double y1, MBByte level )
+{
+    int left   = ( int ) floor( x0 + 0.5 );
+    int top    = ( int ) floor( y0 + 0.5 );
+    int right  = ( int ) floor( x1 + 0.5 );
+    int bottom = ( int ) floor( y1 + 0.5 );
+    int y;
+
+    left   = left   < 0 ? 0 : left;
+    top    = top    < 0 ? 0 : top;
+    right  = right  > image->width  ? image->width  : right;
+    bottom = bottom > image->height ? image->height : bottom;
+
+    for ( y = top; y < bottom; ++y )
+    {
+        if ( right > left )
+        {
+            memset( image->pixels + ( size_t ) y * image->width + left, level, ( size_t ) ( right - left ) );
+        }
+    }
+}
+
+/* outline of a form box, with coordinates in millimetres */
+static void drawBox( GrayImage * image, double pixelsPerMm, double x, double y, double width, double height )
+{
+    double line = 0.25 * pixelsPerMm < 1.0 ? 1.0 : 0.25 * pixelsPerMm;
+
+    x      *= pixelsPerMm;
+    y      *= pixelsPerMm;
+    width  *= pixelsPerMm;
+    height *= pixelsPerMm;
+
+    fillRect( image, x, y, x + width, y + line, FORM_LEVEL );
+    fillRect( image, x, y + height - line, x + width, y + height, FORM_LEVEL );
+    fillRect( image, x, y, x + line, y + height, FORM_LEVEL );
+    fillRect( image, x + width - line, y, x + width, y + height, FORM_LEVEL );
+}
+
+/* row of character cells, i.e. for IBAN and amount */
+static void drawCells( GrayImage * image, double pixelsPerMm, double x, double y, int count, double cellWidth, double height )
+{
+    int i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        drawBox( image, pixelsPerMm, x + i * cellWidth, y, cellWidth, height );
+    }
+}
+
+/* text as glyph-like strokes, since only its texture matters to the recognizer */
+static void drawText( GrayImage * image, Random * random, double pixelsPerMm, double x, double y, char const * text, double advanceMm )
+{
+    double stroke = 0.3 * pixelsPerMm < 1.0 ? 1.0 : 0.3 * pixelsPerMm;
+    double height = 2.6 * pixelsPerMm;
+    double width  = 0.7 * advanceMm * pixelsPerMm;
+
+    x *= pixelsPerMm;
+    y *= pixelsPerMm;
+
+    for ( ; text != NULL && *text != '\0'; ++text, x += advanceMm * pixelsPerMm )
+    {
+        double offset;
+
+        if ( *text == ' ' )
+        {
+            continue;
+        }
+
+        fillRect( image, x, y, x + stroke, y + height, INK_LEVEL );
+        offset = randomUniform( random ) * ( width - stroke );
+        fillRect( image, x + offset, y + ( *text >= 'a' && *text <= 'z' ? 0.35 * height : 0.0 ), x + offset + stroke, y + height, INK_LEVEL );
+        offset = randomUniform( random ) * ( height - stroke );
+        fillRect( image, x, y + offset, x + width, y + offset + stroke, INK_LEVEL );
+    }
+}
+
+/* barcode with its quiet zone, top left corner and module size given in pixels */
+static void drawSymbol( GrayImage * image, Symbol const * symbol, double x, double y, double modulePixels )
+{
+    int right  = ( int ) ( x + ( symbol->width + 2 * symbol->quietZone ) * modulePixels );
+    int bottom = ( int ) ( y + ( symbol->rows * symbol->rowHeight + 2 * symbol->quietZone ) * modulePixels );
+    int px;
+    int py;
+
+    for ( py = ( int ) y; py < bottom && py < image->height; ++py )
+    {
+        for ( px = ( int ) x; px < right && px < image->width; ++px )
+        {
+            int moduleX = ( int ) floor( ( px + 0.5 - x ) / modulePixels ) - symbol->quietZone;
+            int moduleY = ( int ) floor( ( py + 0.5 - y ) / modulePixels ) - symbol->quietZone;
+            int row     = moduleY >= 0 ? moduleY / symbol->rowHeight : -1;
+            int dark    = moduleX >= 0 && moduleX < symbol->width && row >= 0 && row < symbol->rows && symbol->modules[ row * symbol->width + moduleX ];
+
+            if ( px >= 0 && py >= 0 )
+            {
+                image->pixels[ ( size_t ) py * image->width + px ] = ( MBByte ) ( dark ? INK_LEVEL : 255 );
+            }
+        }
+    }
+}
+
+static int renderSlip( GrayImage * page, Random * random, SlipFields const * fields, Symbol const * symbol, double pixelsPerMm, double moduleMm )
+{
+    MBCroatiaBarcodePaymentRecognizerResult const * result = &fields->result;
+
+    double codeWidthMm  = ( symbol->width + 2 * symbol->quietZone ) * moduleMm;
+    double codeHeightMm = ( symbol->rows * symbol->rowHeight + 2 * symbol->quietZone ) * moduleMm;
+
+    /* barcode must fit on the order form, left of the receipt that starts at 150 mm */
+    if ( codeWidthMm > 150.0 - 10.0 || codeHeightMm > SLIP_HEIGHT_MM - 10.0 )
+    {
+        return 0;
+    }
+
+    if ( !imageCreate( page, ( int ) ( SLIP_WIDTH_MM * pixelsPerMm ), ( int ) ( SLIP_HEIGHT_MM * pixelsPerMm ), ( MBByte ) ( PAPER_LEVEL - randomInt( random, 12 ) ) ) )
+    {
+        return 0;
+    }
+
+    /* order form on the left, receipt on the right */
+    drawBox( page, pixelsPerMm, 3.0, 3.0, SLIP_WIDTH_MM - 6.0, SLIP_HEIGHT_MM - 6.0 );
+    fillRect( page, 150.0 * pixelsPerMm, 3.0 * pixelsPerMm, 150.3 * pixelsPerMm, ( SLIP_HEIGHT_MM - 3.0 ) * pixelsPerMm, FORM_LEVEL );
+
+    drawBox( page, pixelsPerMm, 7.0, 8.0, 62.0, 20.0 );
+    drawText( page, random, pixelsPerMm, 9.0, 10.0, result->payerName, 1.9 );
+    drawText( page, random, pixelsPerMm, 9.0, 15.5, result->payerAddress, 1.9 );
+    drawText( page, random, pixelsPerMm, 9.0, 21.0, result->payerDetailedAddress, 1.9 );
+
+    drawBox( page, pixelsPerMm, 7.0, 33.0, 62.0, 20.0 );
+    drawText( page, random, pixelsPerMm, 9.0, 35.0, result->recipientName, 1.9 );
+    drawText( page, random, pixelsPerMm, 9.0, 40.5, result->recipientAddress, 1.9 );
+    drawText( page, random, pixelsPerMm, 9.0, 46.0, result->recipientDetailedAddress, 1.9 );
+
+    drawCells( page, pixelsPerMm, 76.0, 8.0, 3, 3.5, 5.0 );
+    drawText( page, random, pixelsPerMm, 76.8, 9.2, "EUR", 3.5 );
+    drawCells( page, pixelsPerMm, 88.0, 8.0, 15, 3.5, 5.0 );
+    drawText( page, random, pixelsPerMm, 88.8 + ( 15 - ( int ) strlen( fields->amount ) ) * 3.5, 9.2, fields->amount, 3.5 );
+
+    drawCells( page, pixelsPerMm, 76.0, 20.0, 21, 3.2, 5.0 );
+    drawText( page, random, pixelsPerMm, 76.7, 21.2, result->iban, 3.2 );
+
+    drawBox( page, pixelsPerMm, 76.0, 33.0, 14.0, 6.0 );
+    drawText( page, random, pixelsPerMm, 77.5, 34.7, result->referenceModel, 2.6 );
+    drawBox( page, pixelsPerMm, 92.0, 33.0, 50.0, 6.0 );
+    drawText( page, random, pixelsPerMm, 93.5, 34.7, result->reference, 2.1 );
+
+    drawBox( page, pixelsPerMm, 76.0, 45.0, 14.0, 6.0 );
+    drawText( page, random, pixelsPerMm, 77.5, 46.7, result->purposeCode, 2.6 );
+    drawBox( page, pixelsPerMm, 92.0, 45.0, 50.0, 12.0 );
+    drawText( page, random, pixelsPerMm, 93.5, 46.7, result->paymentDescription, 1.9 );
+
+    drawText( page, random, pixelsPerMm, 155.0, 10.0, result->payerName, 1.5 );
+    drawText( page, random, pixelsPerMm, 155.0, 30.0, fields->amount, 1.9 );
+    drawText( page, random, pixelsPerMm, 155.0, 45.0, result->iban, 1.9 );
+    drawText( page, random, pixelsPerMm, 155.0, 60.0, result->recipientName, 1.5 );
+
+    /* barcode is printed in the bottom left corner, over the form if it is large */
+    drawSymbol( page, symbol, 7.0 * pixelsPerMm, ( SLIP_HEIGHT_MM - 5.0 - codeHeightMm ) * pixelsPerMm, moduleMm * pixelsPerMm );
+
+    return 1;
+}
+
+/* solves the 8x8 system of a homography with Gaussian elimination, returns 0 if it is singular */
+static int solveHomography( double h[ 9 ], double const from[ 4 ][ 2 ], double const to[ 4 ][ 2 ] )
+{
+    double a[ 8 ][ 9 ];
+    int    i;
+    int    j;
+    int    k;
+
+    for ( i = 0; i < 4; ++i )
+    {
+        double x = from[ i ][ 0 ];
+        double y = from[ i ][ 1 ];
+        double u = to[ i ][ 0 ];
+        double v = to[ i ][ 1 ];
+        double rowU[ 9 ] = { x, y, 1.0, 0.0, 0.0, 0.0, -u * x, -u * y, u };
+        double rowV[ 9 ] = { 0.0, 0.0, 0.0, x, y, 1.0, -v * x, -v * y, v };
+
+        memcpy( a[ 2 * i ], rowU, sizeof( rowU ) );
+        memcpy( a[ 2 * i + 1 ], rowV, sizeof( rowV ) );
+    }
+
+    for ( i = 0; i < 8; ++i )
+    {
+        int pivot = i;
+
+        for ( j = i + 1; j < 8; ++j )
+        {
+            if ( fabs( a[ j ][ i ] ) > fabs( a[ pivot ][ i ] ) )
+            {
+                pivot = j;
+            }
+        }
+        if ( fabs( a[ pivot ][ i ] ) < 1e-12 )
+        {
+            return 0;
+        }
+        for ( k = 0; k < 9; ++k )
+        {
+            double swap = a[ i ][ k ];
+            a[ i ][ k ]     = a[ pivot ][ k ];
+            a[ pivot ][ k ] = swap;
+        }
+        for ( j = 0; j < 8; ++j )
+        {
+            double factor = a[ j ][ i ] / a[ i ][ i ];
+
+            if ( j == i )
+            {
+                continue;
+            }
+            for ( k = i; k < 9; ++k )
+            {
+                a[ j ][ k ] -= factor * a[ i ][ k ];
+            }
+        }
+    }
+
+    for ( i = 0; i < 8; ++i )
+    {
+        h[ i ] = a[ i ][ 8 ] / a[ i ][ i ];
+    }
+    h[ 8 ] = 1.0;
+
+    return 1;
+}
+
+/* places the slip on a desk, rotated and tilted, as seen by a camera */
+static int photographSlip( GrayImage * photo, GrayImage const * page, Random * random, double rotationDegrees, double perspective )
+{
+    double pageCorners[ 4 ][ 2 ];
+    double photoCorners[ 4 ][ 2 ];
+    double h[ 9 ];
+    double angle   = rotationDegrees * PI / 180.0;
+    double margin  = 0.05 * page->width;
+    double minX    = 1e30;
+    double minY    = 1e30;
+    double maxX    = -1e30;
+    double maxY    = -1e30;
+    int    desk    = 70 + randomInt( random, 60 );
+    int    tiltTop = randomInt( random, 2 );
+    int    x;
+    int    y;
+    int    i;
+
+    pageCorners[ 0 ][ 0 ] = 0.0;                  pageCorners[ 0 ][ 1 ] = 0.0;
+    pageCorners[ 1 ][ 0 ] = ( double ) page->width; pageCorners[ 1 ][ 1 ] = 0.0;
+    pageCorners[ 2 ][ 0 ] = ( double ) page->width; pageCorners[ 2 ][ 1 ] = ( double ) page->height;
+    pageCorners[ 3 ][ 0 ] = 0.0;                  pageCorners[ 3 ][ 1 ] = ( double ) page->height;
+
+    for ( i = 0; i < 4; ++i )
+    {
+        double cx = pageCorners[ i ][ 0 ] - 0.5 * page->width;
+        double cy = pageCorners[ i ][ 1 ] - 0.5 * page->height;
+
+        /* edge further from the camera appears shorter, either the top or the left one */
+        if ( tiltTop )
+        {
+            cx *= cy < 0.0 ? 1.0 - perspective : 1.0;
+        }
+        else
+        {
+            cy *= cx < 0.0 ? 1.0 - perspective : 1.0;
+        }
+
+        photoCorners[ i ][ 0 ] = cx * cos( angle ) - cy * sin( angle );
+        photoCorners[ i ][ 1 ] = cx * sin( angle ) + cy * cos( angle );
+
+        minX = photoCorners[ i ][ 0 ] < minX ? photoCorners[ i ][ 0 ] : minX;
+        minY = photoCorners[ i ][ 1 ] < minY ? photoCorners[ i ][ 1 ] : minY;
+        maxX = photoCorners[ i ][ 0 ] > maxX ? photoCorners[ i ][ 0 ] : maxX;
+        maxY = photoCorners[ i ][ 1 ] > maxY ? photoCorners[ i ][ 1 ] : maxY;
+    }
+    for ( i = 0; i < 4; ++i )
+    {
+        photoCorners[ i ][ 0 ] += margin - minX;
+        photoCorners[ i ][ 1 ] += margin - minY;
+    }
+
+    /* inverse mapping, from photo to page, so that every photo pixel is sampled exactly once */
+    if ( !solveHomography( h, ( double const ( * )[ 2 ] ) photoCorners, ( double const ( * )[ 2 ] ) pageCorners ) ||
+         !imageCreate( photo, ( int ) ( maxX - minX + 2.0 * margin ), ( int ) ( maxY - minY + 2.0 * margin ), ( MBByte ) desk ) )
+    {
+        return 0;
+    }
+
+    for ( y = 0; y < photo->height; ++y )
+    {
+        for ( x = 0; x < photo->width; ++x )
+        {
+            double px = x + 0.5;
+            double py = y + 0.5;
+            double w  = h[ 6 ] * px + h[ 7 ] * py + h[ 8 ];
+            double u  = ( h[ 0 ] * px + h[ 1 ] * py + h[ 2 ] ) / w - 0.5;
+            double v  = ( h[ 3 ] * px + h[ 4 ] * py + h[ 5 ] ) / w - 0.5;
+            int    u0 = ( int ) floor( u );
+            int    v0 = ( int ) floor( v );
+            double fu = u - u0;
+            double fv = v - v0;
+            MBByte const * row;
+
+            if ( u0 < 0 || v0 < 0 || u0 + 1 >= page->width || v0 + 1 >= page->height )
+            {
+                continue;
+            }
+
+            row = page->pixels + ( size_t ) v0 * page->width + u0;
+            photo->pixels[ ( size_t ) y * photo->width + x ] = ( MBByte ) ( ( 1.0 - fv ) * ( ( 1.0 - fu ) * row[ 0 ] + fu * row[ 1 ] ) +
+                                                                            fv * ( ( 1.0 - fu ) * row[ page->width ] + fu * row[ page->width + 1 ] ) + 0.5 );
+        }
+    }
+
+    return 1;
+}
+
+/* separable Gaussian blur with clamped edges */
+static int blurImage( GrayImage * image, double sigma )
+{
+    double   kernel[ 64 ];
+    double * buffer;
+    int      radius = ( int ) ceil( 3.0 * sigma );
+    double   sum    = 0.0;
+    int      x;
+    int      y;
+    int      k;
+
+    if ( sigma < 0.1 )
+    {
+        return 1;
+    }
+    radius = radius > 31 ? 31 : radius;
+
+    for ( k = -radius; k <= radius; ++k )
+    {
+        kernel[ k + radius ] = exp( -0.5 * k * k / ( sigma * sigma ) );
+        sum += kernel[ k + radius ];
+    }
+    for ( k = 0; k <= 2 * radius; ++k )
+    {
+        kernel[ k ] /= sum;
+    }
+
+    buffer = ( double * ) malloc( ( size_t ) image->width * ( size_t ) image->height * sizeof( double ) );
+    if ( buffer == NULL )
+    {
+        return 0;
+    }
+
+    for ( y = 0; y < image->height; ++y )
+    {
+        MBByte const * row = image->pixels + ( size_t ) y * image->width;
+
+        for ( x = 0; x < image->width; ++x )
+        {
+            double value = 0.0;
+
+            for ( k = -radius; k <= radius; ++k )
+            {
+                int sx = x + k < 0 ? 0 : ( x + k >= image->width ? image->width - 1 : x + k );
+                value += kernel[ k + radius ] * row[ sx ];
+            }
+            buffer[ ( size_t ) y * image->width + x ] = value;
+        }
+    }
+
+    for ( y = 0; y < image->height; ++y )
+    {
+        for ( x = 0; x < image->width; ++x )
+        {
+            double value = 0.0;
+
+            for ( k = -radius; k <= radius; ++k )
+            {
+                int sy = y + k < 0 ? 0 : ( y + k >= image->height ? image->height - 1 : y + k );
+                value += kernel[ k + radius ] * buffer[ ( size_t ) sy * image->width + x ];
+            }
+            image->pixels[ ( size_t ) y * image->width + x ] = ( MBByte ) ( value + 0.5 );
+        }
+    }
+
+    free( buffer );
+
+    return 1;
+}
+
+static void addNoise( GrayImage * image, Random * random, double sigma )
+{
+    size_t count = ( size_t ) image->width * ( size_t ) image->height;
+    size_t i;
+
+    if ( sigma <= 0.0 )
+    {
+        return;
+    }
+
+    for ( i = 0; i < count; ++i )
+    {
+        double value = image->pixels[ i ] + sigma * randomGaussian( random ) + 0.5;
+        image->pixels[ i ] = ( MBByte ) ( value < 0.0 ? 0.0 : ( value > 255.0 ? 255.0 : value ) );
+    }
+}
+
+static int createFolder( char const * folder )
+{
+#ifdef _WIN32
+    return CreateDirectoryA( folder, NULL ) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+    return mkdir( folder, 0755 ) == 0 || errno == EEXIST;
+#endif
+}
+
+static uint32_t crc32Update( uint32_t crc, MBByte const * bytes, size_t count )
+{
+    static uint32_t table[ 256 ];
+    static int      tableReady = 0;
+    size_t          i;
+
+    if ( !tableReady )
+    {
+        uint32_t n;
+
+        for ( n = 0; n < 256; ++n )
+        {
+            uint32_t c = n;
+            int      k;
+
+            for ( k = 0; k < 8; ++k )
+            {
+                c = c & 1u ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+            }
+            table[ n ] = c;
+        }
+        tableReady = 1;
+    }
+
+    crc = ~crc;
+    for ( i = 0; i < count; ++i )
+    {
+        crc = table[ ( crc ^ bytes[ i ] ) & 0xFF ] ^ ( crc >> 8 );
+    }
+    return ~crc;
+}
+
+static void storeBigEndian( MBByte * bytes, uint32_t value )
+{
+    bytes[ 0 ] = ( MBByte ) ( value >> 24 );
+    bytes[ 1 ] = ( MBByte ) ( value >> 16 );
+    bytes[ 2 ] = ( MBByte ) ( value >> 8 );
+    bytes[ 3 ] = ( MBByte ) value;
+}
+
+static int writeChunk( FILE * file, char const * type, MBByte const * data, size_t length )
+{
+    MBByte   header[ 8 ];
+    MBByte   trailer[ 4 ];
+    uint32_t crc;
+
+    storeBigEndian( header, ( uint32_t ) length );
+    memcpy( header + 4, type, 4 );
+    crc = crc32Update( 0, header + 4, 4 );
+    crc = crc32Update( crc, data, length );
+    storeBigEndian( trailer, crc );
+
+    return fwrite( header, 1, 8, file ) == 8 && ( length == 0 || fwrite( data, 1, length, file ) == length ) && fwrite( trailer, 1, 4, file ) == 4;
+}
+
+/* 8 bit grayscale PNG whose zlib stream consists of stored blocks, which needs neither compression code nor library */
+static int writePng( char const * path, GrayImage const * image )
+{
+    static MBByte const signature[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    size_t   rowLength = ( size_t ) image->width + 1;
+    size_t   rawLength = rowLength * ( size_t ) image->height;
+    size_t   numBlocks = ( rawLength + 65534 ) / 65535;
+    size_t   zlibLength = 2 + numBlocks * 5 + rawLength + 4;
+    MBByte   ihdr[ 13 ];
+    MBByte * zlib;
+    MBByte * out;
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+    size_t   position = 0;
+    FILE   * file;
+    int      success;
+    int      y;
+
+    zlib = ( MBByte * ) malloc( zlibLength );
+    if ( zlib == NULL )
+    {
+        return 0;
+    }
+
+    out      = zlib;
+    *out++   = 0x78;
+    *out++   = 0x01;
+    for ( y = 0; y < image->height; ++y )
+    {
+        MBByte const * row = image->pixels + ( size_t ) y * image->width;
+        size_t         i;
+
+        /* every row starts with filter type 0, and rows are split into blocks of at most 65535 bytes */
+        for ( i = 0; i < rowLength; ++i, ++position )
+        {
+            MBByte value = i == 0 ? 0 : row[ i - 1 ];
+
+            if ( position % 65535 == 0 )
+            {
+                size_t   blockLength = rawLength - position < 65535 ? rawLength - position : 65535;
+                unsigned length      = ( unsigned ) blockLength;
+
+                *out++ = ( MBByte ) ( position + blockLength == rawLength ? 1 : 0 );
+                *out++ = ( MBByte ) length;
+                *out++ = ( MBByte ) ( length >> 8 );
+                *out++ = ( MBByte ) ~length;
+                *out++ = ( MBByte ) ( ~length >> 8 );
+            }
+
+            *out++ = value;
+            adlerA = ( adlerA + value ) % 65521;
+            adlerB = ( adlerB + adlerA ) % 65521;
+        }
+    }
+    storeBigEndian( out, adlerB << 16 | adlerA );
+
+    storeBigEndian( ihdr, ( uint32_t ) image->width );
+    storeBigEndian( ihdr + 4, ( uint32_t ) image->height );
+    ihdr[ 8 ]  = 8;
+    ihdr[ 9 ]  = 0;
+    ihdr[ 10 ] = 0;
+    ihdr[ 11 ] = 0;
+    ihdr[ 12 ] = 0;
+
+    file = platformOpenFile( path, "wb" );
+    if ( file == NULL )
+    {
+        free( zlib );
+        return 0;
+    }
+
+    success = fwrite( signature, 1, 8, file ) == 8 && writeChunk( file, "IHDR", ihdr, 13 ) &&
+              writeChunk( file, "IDAT", zlib, zlibLength ) && writeChunk( file, "IEND", NULL, 0 );
+
+    success = fclose( file ) == 0 && success;
+    free( zlib );
+
+    return success;
+}
+
+static int writeText( char const * path, char const * text, size_t length )
+{
+    FILE * file = platformOpenFile( path, "wb" );
+    int    success;
+
+    if ( file == NULL )
+    {
+        return 0;
+    }
+    success = fwrite( text, 1, length, file ) == length;
+    return fclose( file ) == 0 && success;
+}
+
+static void symbolFromQrCode( Symbol * symbol, MBQrCode const * code )
+{
+    int x;
+    int y;
+
+    symbol->barcode   = "qr";
+    symbol->version   = code->version;
+    symbol->width     = code->size;
+    symbol->rows      = code->size;
+    symbol->rowHeight = 1;
+    symbol->quietZone = QR_CODE_QUIET_ZONE;
+
+    for ( y = 0; y < code->size; ++y )
+    {
+        for ( x = 0; x < code->size; ++x )
+        {
+            symbol->modules[ y * code->size + x ] = ( MBByte ) qrCodeModule( code, x, y );
+        }
+    }
+}
+
+static int hexDigitValue( char digit )
+{
+    if ( digit >= '0' && digit <= '9' )
+    {
+        return digit - '0';
+    }
+    if ( ( digit | 0x20 ) >= 'a' && ( digit | 0x20 ) <= 'f' )
+    {
+        return ( digit | 0x20 ) - 'a' + 10;
+    }
+    return -1;
+}
+
+/* reads rows printed by the encoder, which must all have the same width */
+static int readPdf417Rows( Symbol * symbol, FILE * output )
+{
+    char   line[ MAX_SYMBOL_WIDTH ];
+    MBByte row[ MAX_SYMBOL_WIDTH ];
+
+    while ( fgets( line, sizeof( line ), output ) != NULL )
+    {
+        char const * digit;
+        int          width = 0;
+
+        for ( digit = line; *digit != '\0'; ++digit )
+        {
+            int value = hexDigitValue( *digit );
+            int bit;
+
+            if ( *digit == ' ' || *digit == '\r' || *digit == '\n' )
+            {
+                continue;
+            }
+            if ( value < 0 || width + 4 > MAX_SYMBOL_WIDTH )
+            {
+                return 0;
+            }
+            for ( bit = 3; bit >= 0; --bit )
+            {
+                row[ width++ ] = ( MBByte ) ( ( value >> bit ) & 1 );
+            }
+        }
+
+        if ( width == 0 )
+        {
+            continue;
+        }
+        if ( ( symbol->rows > 0 && width != symbol->width ) || ( symbol->rows + 1 ) * width > MAX_SYMBOL_MODULES )
+        {
+            return 0;
+        }
+        memcpy( symbol->modules + symbol->rows * width, row, ( size_t ) width );
+        symbol->width = width;
+        ++symbol->rows;
+    }
+
+    return symbol->rows > 0;
+}
+
+/* runs the external encoder on the payload file, replacing every %s of the command with its path */
+static int encodePdf417( Symbol * symbol, char const * encoder, char const * payloadPath )
+{
+    char         command[ MAX_COMMAND_LENGTH ];
+    size_t       length     = 0;
+    size_t       pathLength = strlen( payloadPath );
+    char const * c;
+    FILE       * output;
+    int          success;
+
+    for ( c = encoder; *c != '\0'; ++c )
+    {
+        char const * part       = c;
+        size_t       partLength = 1;
+
+        if ( c[ 0 ] == '%' && c[ 1 ] == 's' )
+        {
+            part       = payloadPath;
+            partLength = pathLength;
+            ++c;
+        }
+        if ( length + partLength >= sizeof( command ) )
+        {
+            return 0;
+        }
+        memcpy( command + length, part, partLength );
+        length += partLength;
+    }
+    command[ length ] = '\0';
+
+    symbol->barcode   = "pdf417";
+    symbol->version   = 0;
+    symbol->width     = 0;
+    symbol->rows      = 0;
+    symbol->rowHeight = PDF417_ROW_HEIGHT;
+    symbol->quietZone = PDF417_QUIET_ZONE;
+
+    output = platformOpenCommand( command );
+    if ( output == NULL )
+    {
+        return 0;
+    }
+    success = readPdf417Rows( symbol, output );
+    return platformCloseCommand( output ) == 0 && success;
+}
+
+static int generateSlip( CorpusOptions const * options, int index, FILE * manifest, FILE * parameters, MBQrCode * code, Symbol * symbol )
+{
+    SlipFields     fields;
+    SlipParameters slip;
+    GrayImage      page;
+    GrayImage      photo;
+    Random         random;
+    char           payload[ MB_CROATIA_PAYMENT_PAYLOAD_MAX_LENGTH + 1 ];
+    char           path[ MAX_PATH_LENGTH ];
+    size_t         payloadLength;
+    double         pixelsPerMm = options->dpi / MM_PER_INCH;
+    int            pdf417      = options->barcode == BARCODE_PDF417 || ( options->barcode == BARCODE_MIXED && index % 2 == 0 );
+    int            success;
+
+    /* every image has its own stream, so it does not depend on the images before it */
+    random.state = options->seed * 0x100000001B3ull + ( uint64_t ) index;
+    randomNext( &random );
+
+    generatePayment( &fields, &random );
+    if ( croatiaPaymentPayloadBuild( payload, sizeof( payload ), &fields.result, &payloadLength ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to build payload of image %d\n", index );
+        return 0;
+    }
+
+    /* payload is written first, since it is the input of the PDF417 encoder */
+    snprintf( path, sizeof( path ), "%s/slip-%05d.txt", options->output, index );
+    if ( !writeText( path, payload, payloadLength ) )
+    {
+        fprintf( stderr, "Failed to write image %d\n", index );
+        return 0;
+    }
+
+    if ( pdf417 )
+    {
+        if ( !encodePdf417( symbol, options->pdf417Encoder, path ) )
+        {
+            fprintf( stderr, "Failed to encode payload of image %d into PDF417 with '%s', use --pdf417-encoder or --barcode qr\n", index, options->pdf417Encoder );
+            return 0;
+        }
+    }
+    else
+    {
+        if ( qrCodeEncodeBytes( code, ( MBByte const * ) payload, payloadLength, options->errorCorrection, 1 ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            fprintf( stderr, "Failed to encode payload of image %d\n", index );
+            return 0;
+        }
+        symbolFromQrCode( symbol, code );
+    }
+
+    slip.moduleMm        = randomInRange( &random, &options->moduleMm );
+    slip.rotationDegrees = randomInRange( &random, &options->rotationDegrees );
+    slip.perspective     = randomInRange( &random, &options->perspective );
+    slip.blurSigma       = randomInRange( &random, &options->blurSigma );
+    slip.noiseSigma      = randomInRange( &random, &options->noiseSigma );
+
+    if ( !renderSlip( &page, &random, &fields, symbol, pixelsPerMm, slip.moduleMm ) )
+    {
+        fprintf( stderr, "Failed to render image %d, barcode of %.2f mm modules may not fit on the slip\n", index, slip.moduleMm );
+        return 0;
+    }
+    success = photographSlip( &photo, &page, &random, slip.rotationDegrees, slip.perspective );
+    imageFree( &page );
+    if ( !success )
+    {
+        fprintf( stderr, "Failed to photograph image %d\n", index );
+        return 0;
+    }
+
+    success = blurImage( &photo, slip.blurSigma );
+    addNoise( &photo, &random, slip.noiseSigma );
+
+    snprintf( path, sizeof( path ), "%s/slip-%05d.png", options->output, index );
+    success = success && writePng( path, &photo );
+    imageFree( &photo );
+
+    if ( !success )
+    {
+        fprintf( stderr, "Failed to write image %d\n", index );
+        return 0;
+    }
+
+    fprintf( manifest, "slip-%05d.png\n", index );
+    fprintf( parameters, "slip-%05d.png\t%s\t%d\t%.3f\t%.2f\t%.2f\t%.3f\t%.2f\t%.2f\n", index, symbol->barcode, symbol->version, slip.moduleMm,
+             slip.moduleMm * pixelsPerMm, slip.rotationDegrees, slip.perspective, slip.blurSigma, slip.noiseSigma );
+
+    return 1;
+}
+
+static void printUsage( char const * program )
+{
+    printf( "usage %s [options] <output directory>\n", program );
+    printf( "  --count <n>                    number of images, 100 by default\n" );
+    printf( "  --seed <n>                     seed of the corpus, 1 by default\n" );
+    printf( "  --dpi <n>                      resolution at which the slip is printed, 200 by default\n" );
+    printf( "  --barcode <pdf417|qr|mixed>    barcode printed on the slips, mixed alternates starting with PDF417, pdf417 by default\n" );
+    printf( "  --pdf417-encoder <command>     command that encodes the payload file %%s into PDF417, by default\n" );
+    printf( "                                 %s\n", DEFAULT_PDF417_ENCODER );
+    printf( "  --module <mm>                  size of barcode module, 0.4:0.6 mm by default\n" );
+    printf( "  --error-correction <L|M|Q|H>   error correction level of QR codes, M by default\n" );
+    printf( "  --rotation <degrees>           rotation of the slip, -10:10 by default\n" );
+    printf( "  --perspective <fraction>       difference in scale between opposite edges of the slip, 0:0.15 by default\n" );
+    printf( "  --blur <pixels>                standard deviation of Gaussian blur, 0:1.2 by default\n" );
+    printf( "  --noise <levels>               standard deviation of Gaussian noise, in gray levels, 0:8 by default\n" );
+    printf( "Ranges are given as min:max, or as a single value.\n" );
+}
+
+static int parseRange( Range * range, char const * argument, double minimum, double maximum )
+{
+    char * end;
+
+    range->minimum = strtod( argument, &end );
+    range->maximum = range->minimum;
+    if ( end == argument )
+    {
+        return 0;
+    }
+    if ( *end == ':' )
+    {
+        char const * start = end + 1;
+
+        range->maximum = strtod( start, &end );
+        if ( end == start )
+        {
+            return 0;
+        }
+    }
+
+    return *end == '\0' && range->minimum >= minimum && range->maximum <= maximum && range->minimum <= range->maximum;
+}
+
+static int parseInteger( long * value, char const * argument, long minimum, long maximum )
+{
+    char * end;
+
+    *value = strtol( argument, &end, 10 );
+    return end != argument && *end == '\0' && *value >= minimum && *value <= maximum;
+}
+
+static int parseOptions( CorpusOptions * options, int argc, char * argv[] )
+{
+    int i;
+
+    memset( options, 0, sizeof( CorpusOptions ) );
+    options->count                   = 100;
+    options->seed                    = 1;
+    options->dpi                     = 200;
+    options->barcode                 = BARCODE_PDF417;
+    options->pdf417Encoder           = DEFAULT_PDF417_ENCODER;
+    options->moduleMm.minimum        = 0.4;
+    options->moduleMm.maximum        = 0.6;
+    options->errorCorrection         = MB_QR_CODE_ERROR_CORRECTION_M;
+    options->rotationDegrees.minimum = -10.0;
+    options->rotationDegrees.maximum = 10.0;
+    options->perspective.maximum     = 0.15;
+    options->blurSigma.maximum       = 1.2;
+    options->noiseSigma.maximum      = 8.0;
+
+    for ( i = 1; i < argc; ++i )
+    {
+        char const * option   = argv[ i ];
+        char const * argument = i + 1 < argc ? argv[ i + 1 ] : NULL;
+        long         value    = 0;
+        int          valid;
+
+        if ( option[ 0 ] != '-' )
+        {
+            if ( options->output != NULL )
+            {
+                return 0;
+            }
+            options->output = option;
+            continue;
+        }
+        if ( argument == NULL )
+        {
+            return 0;
+        }
+
+        if ( strcmp( option, "--count" ) == 0 )
+        {
+            valid          = parseInteger( &value, argument, 1, 99999 );
+            options->count = ( int ) value;
+        }
+        else if ( strcmp( option, "--seed" ) == 0 )
+        {
+            valid         = parseInteger( &value, argument, 0, 2147483647L );
+            options->seed = ( unsigned long ) value;
+        }
+        else if ( strcmp( option, "--dpi" ) == 0 )
+        {
+            valid        = parseInteger( &value, argument, 50, 1200 );
+            options->dpi = ( int ) value;
+        }
+        else if ( strcmp( option, "--barcode" ) == 0 )
+        {
+            int b;
+
+            valid = 0;
+            for ( b = 0; b < ( int ) ( sizeof( barcodeNames ) / sizeof( barcodeNames[ 0 ] ) ); ++b )
+            {
+                if ( strcmp( argument, barcodeNames[ b ] ) == 0 )
+                {
+                    options->barcode = ( Barcode ) b;
+                    valid            = 1;
+                }
+            }
+        }
+        else if ( strcmp( option, "--pdf417-encoder" ) == 0 )
+        {
+            valid                  = strstr( argument, "%s" ) != NULL;
+            options->pdf417Encoder = argument;
+        }
+        else if ( strcmp( option, "--module" ) == 0 )
+        {
+            valid = parseRange( &options->moduleMm, argument, 0.05, 5.0 );
+        }
+        else if ( strcmp( option, "--error-correction" ) == 0 )
+        {
+            char const * levels = "LMQH";
+            char const * level  = argument[ 0 ] != '\0' && argument[ 1 ] == '\0' ? strchr( levels, argument[ 0 ] ) : NULL;
+
+            valid = level != NULL;
+            if ( valid )
+            {
+                options->errorCorrection = ( MBQrCodeErrorCorrection ) ( level - levels );
+            }
+        }
+        else if ( strcmp( option, "--rotation" ) == 0 )
+        {
+            valid = parseRange( &options->rotationDegrees, argument, -180.0, 180.0 );
+        }
+        else if ( strcmp( option, "--perspective" ) == 0 )
+        {
+            valid = parseRange( &options->perspective, argument, 0.0, 0.9 );
+        }
+        else if ( strcmp( option, "--blur" ) == 0 )
+        {
+            valid = parseRange( &options->blurSigma, argument, 0.0, 10.0 );
+        }
+        else if ( strcmp( option, "--noise" ) == 0 )
+        {
+            valid = parseRange( &options->noiseSigma, argument, 0.0, 128.0 );
+        }
+        else
+        {
+            valid = 0;
+        }
+
+        if ( !valid )
+        {
+            fprintf( stderr, "Invalid option %s %s\n", option, argument );
+            return 0;
+        }
+        ++i;
+    }
+
+    return options->output != NULL;
+}
+
+int main( int argc, char * argv[] )
+{
+    CorpusOptions options;
+    MBQrCode    * code;
+    Symbol      * symbol;
+    FILE        * manifest;
+    FILE        * parameters;
+    char          path[ MAX_PATH_LENGTH ];
+    int           numGenerated = 0;
+    int           i;
+
+    if ( !parseOptions( &options, argc, argv ) )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    if ( !createFolder( options.output ) )
+    {
+        fprintf( stderr, "Failed to create folder '%s'\n", options.output );
+        return EXIT_FAILURE;
+    }
+
+    code   = ( MBQrCode * ) malloc( sizeof( MBQrCode ) );
+    symbol = ( Symbol * ) malloc( sizeof( Symbol ) );
+
+    snprintf( path, sizeof( path ), "%s/manifest.txt", options.output );
+    manifest = platformOpenFile( path, "w" );
+    snprintf( path, sizeof( path ), "%s/parameters.tsv", options.output );
+    parameters = platformOpenFile( path, "w" );
+
+    if ( code == NULL || symbol == NULL || manifest == NULL || parameters == NULL )
+    {
+        fprintf( stderr, "Failed to create manifest in '%s'\n", options.output );
+        free( code );
+        free( symbol );
+        if ( manifest != NULL )
+        {
+            fclose( manifest );
+        }
+        if ( parameters != NULL )
+        {
+            fclose( parameters );
+        }
+        return EXIT_FAILURE;
+    }
+
+    fprintf( manifest, "# photopay-corpusgen --seed %lu --count %d --dpi %d --barcode %s\n", options.seed, options.count, options.dpi, barcodeNames[ options.barcode ] );
+    fprintf( parameters, "image\tbarcode\tversion\tmoduleMm\tmodulePixels\trotationDegrees\tperspective\tblurSigma\tnoiseSigma\n" );
+
+    for ( i = 0; i < options.count; ++i )
+    {
+        numGenerated += generateSlip( &options, i, manifest, parameters, code, symbol );
+    }
+
+    fclose( manifest );
+    fclose( parameters );
+    free( code );
+    free( symbol );
+
+    printf( "Generated %d of %d images in '%s'\n", numGenerated, options.count, options.output );
+
+    return numGenerated == options.count ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -11,6 +11,7 @@
 
 #include "Recognizer/RecognizerImage.h"
 #include <LicenseKey.h>
+#include <LocalCacheLocation.h>
 
 #include <RecognizerApi.h>
 
@@ -38,7 +39,11 @@ int main( int argc, char * argv[] )
         return EXIT_FAILURE;
     }
 
-    recognizerAPISetCacheLocation( "." );
+    /* keep license counters on the local disk, even if home folder is mounted over network */
+    if ( localCacheLocationApply( "PhotoPayDemo" ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recognizerAPISetCacheLocation( "." );
+    }
 
     /* Unlock the Recognizer API with your license key */
 
@@ -0,0 +1,978 @@
+/**
+* Copyright (c) Microblink Ltd. All rights reserved.
+*
+* ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+* OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+* WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+* UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+* THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+* REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+*/
+
+/*
+ * photopay-perfcheck - detects performance regressions of recognition by comparing a fixed corpus against a baseline.
+ *
+ * usage: photopay-perfcheck [options] <directory|manifest> <baseline>
+ *
+ * Images are taken from a directory or manifest, the same way as in photopay-bench. Every image is recognized by a
+ * single warmed up recognizer runner with PDF417 and QR payment recognizers, several times in round-robin order,
+ * and the median of each stage (total, preparation, detection and processing, @see RecognitionStats.h) is taken as
+ * its measurement. The SDK does not expose its allocations, so peak RSS of the process is measured instead.
+ *
+ * Measurement is compared against the baseline file, summed over the images present in both. A stage regresses when
+ * its corpus total is slower than in the baseline by more than the threshold and by more than the noise floor, peak
+ * RSS regresses when it grew by more than the threshold, and an image regresses when its result state got worse, i.e.
+ * it was valid and is now empty. A single image is measured too few times to be gated without flaking on a large
+ * corpus, so its slower and faster stages are only listed, to show where to profile. Regressions are printed from the
+ * largest one, and the program exits with 2, so that it can fail a CI job. Errors exit with 1, which includes a
+ * baseline that shares no image with the corpus, and baseline images missing from the corpus.
+ *
+ * With --update-baseline the measurement is written into the baseline file instead, which should then be committed
+ * together with the SDK update. Timings depend on the machine, so baseline should be recorded and checked on the
+ * same machine, i.e. a dedicated CI runner.
+ *
+ * options:
+ *   --threshold <percent>      allowed slowdown of a stage total or peak RSS, 10 by default
+ *   --noise-floor <ms>         smaller slowdowns of a stage total are never regressions, 0.5 by default
+ *   --repetitions <n>          recognitions of every image whose median is taken, 5 by default
+ *   --warmup <n>               images recognized before measuring, 5 by default
+ *   --update-baseline          write the measurement into the baseline instead of comparing
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <BenchmarkRunner.h>
+#include <ImageCorpus.h>
+#include <Platform.h>
+#include <RecognitionStats.h>
+
+#include <RecognizerApi.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PATH_LENGTH     1024
+#define MAX_VERSION_LENGTH  64
+
+/* exit code when the measurement is slower than the baseline, distinct from EXIT_FAILURE which reports errors */
+#define EXIT_REGRESSION     2
+
+#define BASELINE_HEADER     "image\tstate\ttotalNs\tpreparationNs\tdetectionNs\tprocessingNs\tdetectionAttempts"
+
+typedef enum Stage
+{
+    STAGE_TOTAL = 0,
+    STAGE_PREPARATION,
+    STAGE_DETECTION,
+    STAGE_PROCESSING,
+    NUM_STAGES
+} Stage;
+
+static char const * const stageNames[ NUM_STAGES ] = { "total", "preparation", "detection", "processing" };
+
+/* names of result states in the baseline file, indexed by MBRecognizerResultState */
+static char const * const stateNames[] = { "empty", "uncertain", "valid", "stage-valid" };
+
+#define NUM_STATES ( sizeof( stateNames ) / sizeof( stateNames[ 0 ] ) )
+
+typedef struct PerfOptions
+{
+    double       thresholdPercent;
+    double       noiseFloorNs;
+    int          repetitions;
+    int          warmup;
+    int          updateBaseline;
+    char const * input;
+    char const * baseline;
+} PerfOptions;
+
+/* measurement of a single image, either from the baseline or from the current run */
+typedef struct ImageRecord
+{
+    char                  * name;
+    MBRecognizerResultState state;
+    size_t                  numDetectionAttempts;
+    uint64_t                stageNs[ NUM_STAGES ];
+} ImageRecord;
+
+typedef struct PerfRecord
+{
+    ImageRecord * images;
+    size_t        count;
+    uint64_t      peakRssBytes;
+    char          sdkVersion[ MAX_VERSION_LENGTH ];
+} PerfRecord;
+
+/* single line of the diff; stage is NUM_STAGES for result state and peak RSS changes */
+typedef struct Difference
+{
+    char const            * image;
+    int                     stage;
+    uint64_t                baselineValue;
+    uint64_t                currentValue;
+    MBRecognizerResultState baselineState;
+    MBRecognizerResultState currentState;
+    double                  change;
+} Difference;
+
+typedef struct DifferenceList
+{
+    Difference * items;
+    size_t       count;
+    size_t       capacity;
+} DifferenceList;
+
+static char * duplicateString( char const * string, size_t length )
+{
+    char * copy = ( char * ) malloc( length + 1 );
+    if ( copy != NULL )
+    {
+        memcpy( copy, string, length );
+        copy[ length ] = '\0';
+    }
+    return copy;
+}
+
+static void recordFree( PerfRecord * record )
+{
+    size_t i;
+
+    for ( i = 0; i < record->count; ++i )
+    {
+        free( record->images[ i ].name );
+    }
+    free( record->images );
+    memset( record, 0, sizeof( PerfRecord ) );
+}
+
+static int compareNanoseconds( void const * a, void const * b )
+{
+    uint64_t first  = *( uint64_t const * ) a;
+    uint64_t second = *( uint64_t const * ) b;
+    return first < second ? -1 : first > second;
+}
+
+static MBRecognizerErrorStatus perfMeasure( PerfRecord * record, MBImageCorpus const * corpus, PerfOptions const * options )
+{
+    MBBenchmarkRunner       runner;
+    MBRecognizerErrorStatus status;
+    uint64_t              * samplesNs;
+    size_t                  repetitions = ( size_t ) options->repetitions;
+    size_t                  i;
+    size_t                  r;
+    int                     s;
+
+    memset( record, 0, sizeof( PerfRecord ) );
+
+    record->images = ( ImageRecord * ) calloc( corpus->count, sizeof( ImageRecord ) );
+    samplesNs      = ( uint64_t * ) malloc( corpus->count * repetitions * NUM_STAGES * sizeof( uint64_t ) );
+    if ( record->images == NULL || samplesNs == NULL )
+    {
+        free( samplesNs );
+        recordFree( record );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    status = benchmarkRunnerCreate( &runner, MB_TRUE, MB_TRUE, NULL );
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        benchmarkRunnerWarmUp( &runner, corpus, ( size_t ) options->warmup );
+
+        /* round-robin, so that a slow period of the machine affects a single repetition of many images rather than all repetitions of one */
+        for ( r = 0; r < repetitions; ++r )
+        {
+            for ( i = 0; i < corpus->count; ++i )
+            {
+                MBRecognitionStats stats;
+                uint64_t         * samples = samplesNs + ( i * repetitions + r ) * NUM_STAGES;
+
+                recognizerRunnerRecognizeFromImageWithStats( runner.recognizerRunner, corpus->entries[ i ].image, MB_FALSE, NULL, &stats );
+
+                samples[ STAGE_TOTAL ]       = stats.totalNs;
+                samples[ STAGE_PREPARATION ] = stats.preparationNs;
+                samples[ STAGE_DETECTION ]   = stats.detectionNs;
+                samples[ STAGE_PROCESSING ]  = stats.processingNs;
+
+                if ( r == 0 )
+                {
+                    record->images[ i ].state                = stats.resultState;
+                    record->images[ i ].numDetectionAttempts = stats.numDetectionAttempts;
+                }
+            }
+        }
+        record->peakRssBytes = platformPeakRssBytes();
+
+        benchmarkRunnerDelete( &runner );
+    }
+
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        uint64_t * stageSamples = ( uint64_t * ) malloc( repetitions * sizeof( uint64_t ) );
+
+        status = stageSamples != NULL ? MB_RECOGNIZER_ERROR_STATUS_SUCCESS : MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+        for ( i = 0; i < corpus->count && status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS; ++i )
+        {
+            record->images[ i ].name = duplicateString( corpus->entries[ i ].name, strlen( corpus->entries[ i ].name ) );
+            if ( record->images[ i ].name == NULL )
+            {
+                status = MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+                break;
+            }
+            ++record->count;
+
+            for ( s = 0; s < NUM_STAGES; ++s )
+            {
+                for ( r = 0; r < repetitions; ++r )
+                {
+                    stageSamples[ r ] = samplesNs[ ( i * repetitions + r ) * NUM_STAGES + s ];
+                }
+                qsort( stageSamples, repetitions, sizeof( uint64_t ), compareNanoseconds );
+                record->images[ i ].stageNs[ s ] = stageSamples[ ( repetitions - 1 ) / 2 ];
+            }
+        }
+        free( stageSamples );
+    }
+
+    free( samplesNs );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recordFree( record );
+    }
+
+    return status;
+}
+
+static char const * stateName( MBRecognizerResultState state )
+{
+    return ( size_t ) state < NUM_STATES ? stateNames[ state ] : "unknown";
+}
+
+static int writeBaseline( PerfRecord const * record, PerfOptions const * options )
+{
+    FILE * file = platformOpenFile( options->baseline, "w" );
+    size_t i;
+    int    success;
+
+    if ( file == NULL )
+    {
+        return 0;
+    }
+
+    fprintf( file, "# photopay-perfcheck baseline, median of %d repetitions, regenerate with --update-baseline\n", options->repetitions );
+    fprintf( file, "sdkVersion\t%s\n", record->sdkVersion );
+    fprintf( file, "peakRssBytes\t%.0f\n", ( double ) record->peakRssBytes );
+    fprintf( file, "%s\n", BASELINE_HEADER );
+    for ( i = 0; i < record->count; ++i )
+    {
+        ImageRecord const * image = &record->images[ i ];
+
+        fprintf( file, "%s\t%s\t%.0f\t%.0f\t%.0f\t%.0f\t%lu\n", image->name, stateName( image->state ),
+                 ( double ) image->stageNs[ STAGE_TOTAL ], ( double ) image->stageNs[ STAGE_PREPARATION ],
+                 ( double ) image->stageNs[ STAGE_DETECTION ], ( double ) image->stageNs[ STAGE_PROCESSING ],
+                 ( unsigned long ) image->numDetectionAttempts );
+    }
+
+    success = !ferror( file );
+    return fclose( file ) == 0 && success;
+}
+
+/* splits the next tab separated field off the line, returns NULL if there are no more fields */
+static char * nextField( char ** line )
+{
+    char * field = *line;
+    char * tab;
+
+    if ( field == NULL )
+    {
+        return NULL;
+    }
+
+    tab = strchr( field, '\t' );
+    if ( tab != NULL )
+    {
+        *tab  = '\0';
+        *line = tab + 1;
+    }
+    else
+    {
+        *line = NULL;
+    }
+    return field;
+}
+
+/* nanoseconds and byte counts are stored as integers, which double represents exactly below 2^53 */
+static int parseCount( uint64_t * value, char const * field )
+{
+    char * end;
+    double parsed;
+
+    if ( field == NULL )
+    {
+        return 0;
+    }
+    parsed = strtod( field, &end );
+    if ( end == field || *end != '\0' || parsed < 0.0 )
+    {
+        return 0;
+    }
+    *value = ( uint64_t ) parsed;
+    return 1;
+}
+
+static int parseImageRecord( ImageRecord * image, char * line )
+{
+    char const * name  = nextField( &line );
+    char const * state = nextField( &line );
+    uint64_t     numDetectionAttempts;
+    size_t       i;
+    int          s;
+
+    memset( image, 0, sizeof( ImageRecord ) );
+    if ( name == NULL || state == NULL || name[ 0 ] == '\0' )
+    {
+        return 0;
+    }
+
+    i = 0;
+    while ( i < NUM_STATES && strcmp( state, stateNames[ i ] ) != 0 )
+    {
+        ++i;
+    }
+    if ( i == NUM_STATES )
+    {
+        return 0;
+    }
+    image->state = ( MBRecognizerResultState ) i;
+
+    for ( s = 0; s < NUM_STAGES; ++s )
+    {
+        if ( !parseCount( &image->stageNs[ s ], nextField( &line ) ) )
+        {
+            return 0;
+        }
+    }
+    if ( !parseCount( &numDetectionAttempts, nextField( &line ) ) || line != NULL )
+    {
+        return 0;
+    }
+    image->numDetectionAttempts = ( size_t ) numDetectionAttempts;
+
+    image->name = duplicateString( name, strlen( name ) );
+    return image->name != NULL;
+}
+
+static int compareImageRecords( void const * a, void const * b )
+{
+    return strcmp( ( ( ImageRecord const * ) a )->name, ( ( ImageRecord const * ) b )->name );
+}
+
+static int readBaseline( PerfRecord * record, char const * path )
+{
+    char     line[ MAX_PATH_LENGTH + 256 ];
+    size_t   capacity   = 0;
+    unsigned lineNumber = 0;
+    FILE   * file       = platformOpenFile( path, "r" );
+
+    memset( record, 0, sizeof( PerfRecord ) );
+    if ( file == NULL )
+    {
+        fprintf( stderr, "Failed to open baseline '%s'. Record it with --update-baseline\n", path );
+        return 0;
+    }
+
+    while ( fgets( line, sizeof( line ), file ) != NULL )
+    {
+        size_t length = strlen( line );
+        char * fields = line;
+        int    valid  = 1;
+
+        ++lineNumber;
+        while ( length > 0 && ( line[ length - 1 ] == '\n' || line[ length - 1 ] == '\r' ) )
+        {
+            line[ --length ] = '\0';
+        }
+        if ( length == 0 || line[ 0 ] == '#' || strcmp( line, BASELINE_HEADER ) == 0 )
+        {
+            continue;
+        }
+
+        if ( strncmp( line, "sdkVersion\t", 11 ) == 0 )
+        {
+            /* versions are written from a buffer of the same size, so a longer one means a damaged baseline */
+            valid = length - 11 < sizeof( record->sdkVersion );
+            if ( valid )
+            {
+                memcpy( record->sdkVersion, line + 11, length - 11 + 1 );
+            }
+        }
+        else if ( strncmp( line, "peakRssBytes\t", 13 ) == 0 )
+        {
+            valid = parseCount( &record->peakRssBytes, line + 13 );
+        }
+        else
+        {
+            if ( record->count == capacity )
+            {
+                size_t        newCapacity = capacity == 0 ? 64 : 2 * capacity;
+                ImageRecord * images      = ( ImageRecord * ) realloc( record->images, newCapacity * sizeof( ImageRecord ) );
+
+                if ( images == NULL )
+                {
+                    fclose( file );
+                    recordFree( record );
+                    return 0;
+                }
+                record->images = images;
+                capacity       = newCapacity;
+            }
+
+            valid = parseImageRecord( &record->images[ record->count ], fields );
+            record->count += valid ? 1 : 0;
+        }
+
+        if ( !valid )
+        {
+            fprintf( stderr, "Invalid line %u of baseline '%s'\n", lineNumber, path );
+            fclose( file );
+            recordFree( record );
+            return 0;
+        }
+    }
+
+    fclose( file );
+
+    if ( record->count > 0 )
+    {
+        qsort( record->images, record->count, sizeof( ImageRecord ), compareImageRecords );
+    }
+    return 1;
+}
+
+static ImageRecord const * findImage( PerfRecord const * record, char const * name )
+{
+    ImageRecord key;
+
+    if ( record->count == 0 )
+    {
+        return NULL;
+    }
+    key.name = ( char * ) name;
+    return ( ImageRecord const * ) bsearch( &key, record->images, record->count, sizeof( ImageRecord ), compareImageRecords );
+}
+
+/* worse states have lower rank, so that valid becoming uncertain is a regression */
+static int stateRank( MBRecognizerResultState state )
+{
+    switch ( state )
+    {
+        case MB_RECOGNIZER_RESULT_STATE_VALID:       return 3;
+        case MB_RECOGNIZER_RESULT_STATE_STAGE_VALID: return 2;
+        case MB_RECOGNIZER_RESULT_STATE_UNCERTAIN:   return 1;
+        default:                                     return 0;
+    }
+}
+
+static double relativeChange( uint64_t baselineValue, uint64_t currentValue )
+{
+    if ( baselineValue == 0 )
+    {
+        return currentValue > 0 ? 1.0 : 0.0;
+    }
+    return ( ( double ) currentValue - ( double ) baselineValue ) / ( double ) baselineValue;
+}
+
+static int differenceAdd( DifferenceList * list, Difference const * difference )
+{
+    if ( list->count == list->capacity )
+    {
+        size_t       capacity = list->capacity == 0 ? 16 : 2 * list->capacity;
+        Difference * items    = ( Difference * ) realloc( list->items, capacity * sizeof( Difference ) );
+
+        if ( items == NULL )
+        {
+            return 0;
+        }
+        list->items    = items;
+        list->capacity = capacity;
+    }
+    list->items[ list->count++ ] = *difference;
+    return 1;
+}
+
+/* adds the stage to slower or faster if it changed by more than both the threshold and the noise floor */
+static int compareStage
+(
+    DifferenceList    * slower,
+    DifferenceList    * faster,
+    PerfOptions const * options,
+    char const        * image,
+    int                 stage,
+    uint64_t            baselineNs,
+    uint64_t            currentNs
+)
+{
+    Difference difference;
+    double     delta = ( double ) currentNs - ( double ) baselineNs;
+
+    memset( &difference, 0, sizeof( Difference ) );
+    difference.image         = image;
+    difference.stage         = stage;
+    difference.baselineValue = baselineNs;
+    difference.currentValue  = currentNs;
+    difference.change        = relativeChange( baselineNs, currentNs );
+
+    if ( delta > options->noiseFloorNs && difference.change * 100.0 > options->thresholdPercent )
+    {
+        return differenceAdd( slower, &difference );
+    }
+    if ( -delta > options->noiseFloorNs && -difference.change * 100.0 > options->thresholdPercent )
+    {
+        return differenceAdd( faster, &difference );
+    }
+    return 1;
+}
+
+/* state changes first, then from the largest relative change */
+static int compareDifferences( void const * a, void const * b )
+{
+    Difference const * first  = ( Difference const * ) a;
+    Difference const * second = ( Difference const * ) b;
+    double             firstMagnitude  = first->change  < 0.0 ? -first->change  : first->change;
+    double             secondMagnitude = second->change < 0.0 ? -second->change : second->change;
+    int                firstIsState    = first->stage  == NUM_STAGES && first->image  != NULL;
+    int                secondIsState   = second->stage == NUM_STAGES && second->image != NULL;
+
+    if ( firstIsState != secondIsState )
+    {
+        return secondIsState - firstIsState;
+    }
+    return firstMagnitude < secondMagnitude ? 1 : ( firstMagnitude > secondMagnitude ? -1 : 0 );
+}
+
+static double milliseconds( uint64_t ns )
+{
+    return ( double ) ns / 1e6;
+}
+
+static double megabytes( uint64_t bytes )
+{
+    return ( double ) bytes / ( 1024.0 * 1024.0 );
+}
+
+static void printDifference( Difference const * difference )
+{
+    if ( difference->stage < NUM_STAGES )
+    {
+        printf( "  %-32s %-12s %10.3f ms -> %10.3f ms  %+7.1f%%\n", difference->image != NULL ? difference->image : "(corpus)",
+                stageNames[ difference->stage ], milliseconds( difference->baselineValue ), milliseconds( difference->currentValue ),
+                100.0 * difference->change );
+    }
+    else if ( difference->image != NULL )
+    {
+        printf( "  %-32s %-12s %13s -> %s\n", difference->image, "state", stateName( difference->baselineState ), stateName( difference->currentState ) );
+    }
+    else
+    {
+        printf( "  %-32s %-12s %10.1f MB -> %10.1f MB  %+7.1f%%\n", "(process)", "peak RSS", megabytes( difference->baselineValue ),
+                megabytes( difference->currentValue ), 100.0 * difference->change );
+    }
+}
+
+static void printDifferences( char const * title, DifferenceList * list )
+{
+    size_t i;
+
+    if ( list->count == 0 )
+    {
+        return;
+    }
+
+    qsort( list->items, list->count, sizeof( Difference ), compareDifferences );
+    printf( "\n%s (%lu):\n", title, ( unsigned long ) list->count );
+    for ( i = 0; i < list->count; ++i )
+    {
+        printDifference( &list->items[ i ] );
+    }
+}
+
+static void differenceListFree( DifferenceList * list )
+{
+    free( list->items );
+    memset( list, 0, sizeof( DifferenceList ) );
+}
+
+/*
+ * prints the diff between baseline and measurement, returns the number of regressions, or -1 if the measurement cannot
+ * be compared with the baseline
+ */
+static int perfCompare( PerfRecord const * baseline, PerfRecord const * current, PerfOptions const * options )
+{
+    DifferenceList regressions;
+    DifferenceList improvements;
+    DifferenceList slowerImages;
+    DifferenceList fasterImages;
+    uint64_t       baselineTotals[ NUM_STAGES ];
+    uint64_t       currentTotals[ NUM_STAGES ];
+    size_t         numCompared = 0;
+    size_t         numNew      = 0;
+    size_t         numMissing  = 0;
+    size_t         i;
+    int            success = 1;
+    int            numRegressions;
+    int            s;
+
+    memset( &regressions, 0, sizeof( DifferenceList ) );
+    memset( &improvements, 0, sizeof( DifferenceList ) );
+    memset( &slowerImages, 0, sizeof( DifferenceList ) );
+    memset( &fasterImages, 0, sizeof( DifferenceList ) );
+    memset( baselineTotals, 0, sizeof( baselineTotals ) );
+    memset( currentTotals, 0, sizeof( currentTotals ) );
+
+    for ( i = 0; i < current->count && success; ++i )
+    {
+        ImageRecord const * image    = &current->images[ i ];
+        ImageRecord const * previous = findImage( baseline, image->name );
+
+        if ( previous == NULL )
+        {
+            ++numNew;
+            continue;
+        }
+        ++numCompared;
+
+        if ( stateRank( image->state ) != stateRank( previous->state ) )
+        {
+            Difference difference;
+
+            memset( &difference, 0, sizeof( Difference ) );
+            difference.image         = image->name;
+            difference.stage         = NUM_STAGES;
+            difference.baselineState = previous->state;
+            difference.currentState  = image->state;
+            success = differenceAdd( stateRank( image->state ) < stateRank( previous->state ) ? &regressions : &improvements, &difference );
+        }
+
+        /* a median of a few recognitions of a single image is too noisy to gate on, so it is only reported */
+        for ( s = 0; s < NUM_STAGES && success; ++s )
+        {
+            baselineTotals[ s ] += previous->stageNs[ s ];
+            currentTotals[ s ]  += image->stageNs[ s ];
+            success = compareStage( &slowerImages, &fasterImages, options, image->name, s, previous->stageNs[ s ], image->stageNs[ s ] );
+        }
+    }
+
+    for ( i = 0; i < baseline->count; ++i )
+    {
+        numMissing += findImage( current, baseline->images[ i ].name ) == NULL ? 1 : 0;
+    }
+
+    for ( s = 0; s < NUM_STAGES && success; ++s )
+    {
+        success = compareStage( &regressions, &improvements, options, NULL, s, baselineTotals[ s ], currentTotals[ s ] );
+    }
+
+    if ( success && baseline->peakRssBytes > 0 && current->peakRssBytes > 0 )
+    {
+        Difference difference;
+
+        memset( &difference, 0, sizeof( Difference ) );
+        difference.stage         = NUM_STAGES;
+        difference.baselineValue = baseline->peakRssBytes;
+        difference.currentValue  = current->peakRssBytes;
+        difference.change        = relativeChange( baseline->peakRssBytes, current->peakRssBytes );
+        if ( 100.0 * difference.change > options->thresholdPercent )
+        {
+            success = differenceAdd( &regressions, &difference );
+        }
+        else if ( -100.0 * difference.change > options->thresholdPercent )
+        {
+            success = differenceAdd( &improvements, &difference );
+        }
+    }
+
+    if ( !success )
+    {
+        fprintf( stderr, "Failed to allocate the comparison\n" );
+    }
+    else if ( numCompared == 0 )
+    {
+        /* an empty comparison would pass whatever the SDK does, which usually means that the corpus was moved or renamed */
+        fprintf( stderr, "None of the %lu images is in the baseline, which lists %lu images. Check the corpus, or record a new baseline with --update-baseline.\n",
+                 ( unsigned long ) current->count, ( unsigned long ) baseline->count );
+        success = 0;
+    }
+
+    if ( !success )
+    {
+        differenceListFree( &regressions );
+        differenceListFree( &improvements );
+        differenceListFree( &slowerImages );
+        differenceListFree( &fasterImages );
+        return -1;
+    }
+
+    printf( "Compared %lu images, median of %d repetitions, threshold %.1f%%, noise floor %.2f ms\n", ( unsigned long ) numCompared,
+            options->repetitions, options->thresholdPercent, options->noiseFloorNs / 1e6 );
+    printf( "SDK %s, baseline recorded with SDK %s\n\n", current->sdkVersion, baseline->sdkVersion[ 0 ] != '\0' ? baseline->sdkVersion : "(unknown)" );
+
+    printf( "  %-32s %-12s %13s    %13s  %8s\n", "", "stage", "baseline", "current", "change" );
+    for ( s = 0; s < NUM_STAGES; ++s )
+    {
+        printf( "  %-32s %-12s %10.3f ms -> %10.3f ms  %+7.1f%%\n", "(corpus)", stageNames[ s ], milliseconds( baselineTotals[ s ] ),
+                milliseconds( currentTotals[ s ] ), 100.0 * relativeChange( baselineTotals[ s ], currentTotals[ s ] ) );
+    }
+    printf( "  %-32s %-12s %10.1f MB -> %10.1f MB  %+7.1f%%\n", "(process)", "peak RSS", megabytes( baseline->peakRssBytes ),
+            megabytes( current->peakRssBytes ), 100.0 * relativeChange( baseline->peakRssBytes, current->peakRssBytes ) );
+
+    printDifferences( "Regressions", &regressions );
+    printDifferences( "Improvements", &improvements );
+    printDifferences( "Slower images, not gated", &slowerImages );
+    printDifferences( "Faster images, not gated", &fasterImages );
+
+    if ( numNew > 0 )
+    {
+        printf( "\nNot in the baseline, not compared (%lu):\n", ( unsigned long ) numNew );
+        for ( i = 0; i < current->count; ++i )
+        {
+            if ( findImage( baseline, current->images[ i ].name ) == NULL )
+            {
+                printf( "  %s\n", current->images[ i ].name );
+            }
+        }
+    }
+    if ( numMissing > 0 )
+    {
+        printf( "\nMissing from the corpus (%lu):\n", ( unsigned long ) numMissing );
+        for ( i = 0; i < baseline->count; ++i )
+        {
+            if ( findImage( current, baseline->images[ i ].name ) == NULL )
+            {
+                printf( "  %s\n", baseline->images[ i ].name );
+            }
+        }
+    }
+
+    numRegressions = ( int ) regressions.count;
+    if ( numMissing > 0 )
+    {
+        /* totals without the missing images would hide their slowdown, so the corpus and the baseline must be fixed first */
+        printf( "\nERROR: %lu baseline images are missing from the corpus. Restore them, or record a new baseline with --update-baseline and commit it.\n",
+                ( unsigned long ) numMissing );
+        numRegressions = -1;
+    }
+    else if ( numRegressions > 0 )
+    {
+        printf( "\nFAILED: %d regressions. Profile the slower images and stages; if the change is expected, record a new baseline with --update-baseline and commit it.\n", numRegressions );
+    }
+    else
+    {
+        printf( "\nPASSED%s\n", improvements.count > 0 || numNew > 0 ? ", consider recording a new baseline with --update-baseline" : "" );
+    }
+
+    differenceListFree( &regressions );
+    differenceListFree( &improvements );
+    differenceListFree( &slowerImages );
+    differenceListFree( &fasterImages );
+
+    return numRegressions;
+}
+
+static void printUsage( char const * program )
+{
+    printf( "usage %s [options] <directory|manifest> <baseline>\n", program );
+    printf( "  --threshold <percent>      allowed slowdown of a stage total or peak RSS, 10 by default\n" );
+    printf( "  --noise-floor <ms>         smaller slowdowns of a stage total are never regressions, 0.5 by default\n" );
+    printf( "  --repetitions <n>          recognitions of every image whose median is taken, 5 by default\n" );
+    printf( "  --warmup <n>               images recognized before measuring, 5 by default\n" );
+    printf( "  --update-baseline          write the measurement into the baseline instead of comparing\n" );
+    printf( "Exits with 2 if the corpus total of any stage or peak RSS is worse than the baseline by more than the threshold,\n" );
+    printf( "or a result state got worse, and with 1 on errors, including baseline images missing from the corpus.\n" );
+}
+
+static int parsePositive( int * value, char const * argument, int minimum, int maximum )
+{
+    char * end;
+    long   parsed = strtol( argument, &end, 10 );
+
+    if ( end == argument || *end != '\0' || parsed < minimum || parsed > maximum )
+    {
+        return 0;
+    }
+    *value = ( int ) parsed;
+    return 1;
+}
+
+static int parseNonNegative( double * value, char const * argument )
+{
+    char * end;
+    double parsed = strtod( argument, &end );
+
+    if ( end == argument || *end != '\0' || parsed < 0.0 )
+    {
+        return 0;
+    }
+    *value = parsed;
+    return 1;
+}
+
+static int parseOptions( PerfOptions * options, int argc, char * argv[] )
+{
+    int i;
+
+    memset( options, 0, sizeof( PerfOptions ) );
+    options->thresholdPercent = 10.0;
+    options->noiseFloorNs     = 0.5e6;
+    options->repetitions      = 5;
+    options->warmup           = 5;
+
+    for ( i = 1; i < argc; ++i )
+    {
+        char const * option   = argv[ i ];
+        char const * argument = i + 1 < argc ? argv[ i + 1 ] : NULL;
+        int          valid;
+
+        if ( option[ 0 ] != '-' )
+        {
+            if ( options->input == NULL )
+            {
+                options->input = option;
+            }
+            else if ( options->baseline == NULL )
+            {
+                options->baseline = option;
+            }
+            else
+            {
+                return 0;
+            }
+            continue;
+        }
+
+        if ( strcmp( option, "--update-baseline" ) == 0 )
+        {
+            options->updateBaseline = 1;
+            continue;
+        }
+        if ( argument == NULL )
+        {
+            return 0;
+        }
+
+        if ( strcmp( option, "--threshold" ) == 0 )
+        {
+            valid = parseNonNegative( &options->thresholdPercent, argument );
+        }
+        else if ( strcmp( option, "--noise-floor" ) == 0 )
+        {
+            valid = parseNonNegative( &options->noiseFloorNs, argument );
+            options->noiseFloorNs *= 1e6;
+        }
+        else if ( strcmp( option, "--repetitions" ) == 0 )
+        {
+            valid = parsePositive( &options->repetitions, argument, 1, 1000 );
+        }
+        else if ( strcmp( option, "--warmup" ) == 0 )
+        {
+            valid = parsePositive( &options->warmup, argument, 0, 1000000 );
+        }
+        else
+        {
+            valid = 0;
+        }
+
+        if ( !valid )
+        {
+            fprintf( stderr, "Invalid option %s %s\n", option, argument );
+            return 0;
+        }
+        ++i;
+    }
+
+    return options->input != NULL && options->baseline != NULL;
+}
+
+int main( int argc, char * argv[] )
+{
+    PerfOptions             options;
+    MBImageCorpus           corpus;
+    PerfRecord              baseline;
+    PerfRecord              current;
+    MBRecognizerErrorStatus errorStatus;
+    int                     numRegressions;
+
+    if ( !parseOptions( &options, argc, argv ) )
+    {
+        printUsage( argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    errorStatus = benchmarkUnlock( "PhotoPayPerfCheck" );
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to unlock! Reason: %s\n", recognizerErrorToString( errorStatus ) );
+        return EXIT_FAILURE;
+    }
+
+    /* baseline is read first, so that a missing one is reported before the corpus is measured */
+    memset( &baseline, 0, sizeof( PerfRecord ) );
+    if ( !options.updateBaseline && !readBaseline( &baseline, options.baseline ) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    memset( &corpus, 0, sizeof( MBImageCorpus ) );
+    errorStatus = imageCorpusLoad( &corpus, options.input, benchmarkReportLoadFailure, NULL );
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to read image list from '%s'. Reason: %s\n", options.input, recognizerErrorToString( errorStatus ) );
+    }
+    else if ( corpus.count == 0 )
+    {
+        fprintf( stderr, "No images found in '%s'\n", options.input );
+    }
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS || corpus.count == 0 )
+    {
+        imageCorpusFree( &corpus );
+        recordFree( &baseline );
+        return EXIT_FAILURE;
+    }
+
+    errorStatus = perfMeasure( &current, &corpus, &options );
+    imageCorpusFree( &corpus );
+    if ( errorStatus != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        fprintf( stderr, "Failed to measure the corpus. Reason: %s\n", recognizerErrorToString( errorStatus ) );
+        recordFree( &baseline );
+        return EXIT_FAILURE;
+    }
+    snprintf( current.sdkVersion, sizeof( current.sdkVersion ), "%s", recognizerAPIGetVersionString() );
+
+    if ( options.updateBaseline )
+    {
+        int written = writeBaseline( &current, &options );
+
+        if ( written )
+        {
+            printf( "Recorded baseline of %lu images into '%s'\n", ( unsigned long ) current.count, options.baseline );
+        }
+        else
+        {
+            fprintf( stderr, "Failed to write baseline '%s'\n", options.baseline );
+        }
+        recordFree( &current );
+        return written ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    numRegressions = perfCompare( &baseline, &current, &options );
+    recordFree( &baseline );
+    recordFree( &current );
+
+    if ( numRegressions < 0 )
+    {
+        return EXIT_FAILURE;
+    }
+    return numRegressions > 0 ? EXIT_REGRESSION : EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "BarcodeLocation.h"
+#include "RecognizerImageUtils.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef struct LocationCollector
+{
+    /* last accepted detection, which becomes the reported location only if recognition produces a result */
+    MBBarcodeLocation                   * location;
+    MBUserDataRecognitionCallback const * userCallback;
+    int                                   imageWidth;
+    int                                   imageHeight;
+} LocationCollector;
+
+static int clamp( int value, int minimum, int maximum )
+{
+    return value < minimum ? minimum : value > maximum ? maximum : value;
+}
+
+static float distance( MBPoint const * a, MBPoint const * b )
+{
+    float dx = ( float ) ( a->x - b->x );
+    float dy = ( float ) ( a->y - b->y );
+    return ( float ) sqrt( dx * dx + dy * dy );
+}
+
+static void storeLocation( LocationCollector * collector, MBPoint const * points, size_t pointsSize )
+{
+    MBBarcodeLocation * location = collector->location;
+    int                 left, top, right, bottom;
+    size_t              i;
+
+    memset( location, 0, sizeof( MBBarcodeLocation ) );
+    if ( points == NULL || pointsSize == 0 )
+    {
+        return;
+    }
+
+    left  = right  = points[ 0 ].x;
+    top   = bottom = points[ 0 ].y;
+    for ( i = 1; i < pointsSize; ++i )
+    {
+        if ( points[ i ].x < left   ) left   = points[ i ].x;
+        if ( points[ i ].x > right  ) right  = points[ i ].x;
+        if ( points[ i ].y < top    ) top    = points[ i ].y;
+        if ( points[ i ].y > bottom ) bottom = points[ i ].y;
+    }
+
+    left   = clamp( left,   0, collector->imageWidth  );
+    right  = clamp( right,  0, collector->imageWidth  );
+    top    = clamp( top,    0, collector->imageHeight );
+    bottom = clamp( bottom, 0, collector->imageHeight );
+
+    location->found              = MB_TRUE;
+    location->pointsSize         = pointsSize < MB_BARCODE_LOCATION_MAX_POINTS ? pointsSize : MB_BARCODE_LOCATION_MAX_POINTS;
+    memcpy( location->points, points, location->pointsSize * sizeof( MBPoint ) );
+    location->boundingBox.x      = ( float ) left;
+    location->boundingBox.y      = ( float ) top;
+    location->boundingBox.width  = ( float ) ( right - left );
+    location->boundingBox.height = ( float ) ( bottom - top );
+
+    if ( pointsSize == 4 )
+    {
+        location->symbolSize.width  = ( int ) ( ( distance( &points[ 0 ], &points[ 1 ] ) + distance( &points[ 2 ], &points[ 3 ] ) ) / 2.f + .5f );
+        location->symbolSize.height = ( int ) ( ( distance( &points[ 1 ], &points[ 2 ] ) + distance( &points[ 3 ], &points[ 0 ] ) ) / 2.f + .5f );
+    }
+    else
+    {
+        location->symbolSize.width  = right - left;
+        location->symbolSize.height = bottom - top;
+    }
+}
+
+static MBBool onDetectedObject( void * userData, MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    MBBool              proceed   = MB_TRUE;
+
+    if ( collector->userCallback->onDetectedObject != NULL )
+    {
+        proceed = collector->userCallback->onDetectedObject( collector->userCallback->userData, points, pointsSize, detectionStatus );
+    }
+
+    /* rejected detections are not processed further, so they can never produce the result */
+    if ( detectionStatus == DETECTION_STATUS_SUCCESS && proceed )
+    {
+        storeLocation( collector, points, pointsSize );
+    }
+    return proceed;
+}
+
+static void onDetectionStarted( void * userData )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onDetectionStarted( collector->userCallback->userData );
+}
+
+static void onDetectionMidway( void * userData, MBPoint const * points, size_t pointsSize )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onDetectionMidway( collector->userCallback->userData, points, pointsSize );
+}
+
+static void onDetectionFailed( void * userData )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onDetectionFailed( collector->userCallback->userData );
+}
+
+static void onRecognitionStarted( void * userData )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onRecognitionStarted( collector->userCallback->userData );
+}
+
+static void onRecognitionFinished( void * userData )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onRecognitionFinished( collector->userCallback->userData );
+}
+
+static void onGlare( void * userData, MBBool hasGlare )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onGlare( collector->userCallback->userData, hasGlare );
+}
+
+static void onShowImage( void * userData, MBRecognizerImage const * image, MBShowImageType showType, char const * name )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onShowImage( collector->userCallback->userData, image, showType, name );
+}
+
+static void onFirstSideResult( void * userData )
+{
+    LocationCollector * collector = ( LocationCollector * ) userData;
+    collector->userCallback->onFirstSideResult( collector->userCallback->userData );
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithLocation
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback,
+    MBBarcodeLocation                   * location
+)
+{
+    MBUserDataRecognitionCallback emptyCallback;
+    MBUserDataRecognitionCallback locationCallback;
+    LocationCollector             collector;
+    MBRecognizerResultState       state;
+
+    if ( location == NULL )
+    {
+        return recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, image, imageIsVideoFrame, callback );
+    }
+
+    if ( callback == NULL )
+    {
+        userDataRecognitionCallbackDefaultInit( &emptyCallback );
+        callback = &emptyCallback;
+    }
+
+    memset( location, 0, sizeof( MBBarcodeLocation ) );
+
+    userDataRecognitionCallbackDefaultInit( &locationCallback );
+    locationCallback.userData              = &collector;
+    locationCallback.onDetectionStarted    = callback->onDetectionStarted    != NULL ? onDetectionStarted    : NULL;
+    locationCallback.onDetectionMidway     = callback->onDetectionMidway     != NULL ? onDetectionMidway     : NULL;
+    locationCallback.onDetectedObject      = onDetectedObject;
+    locationCallback.onDetectionFailed     = callback->onDetectionFailed     != NULL ? onDetectionFailed     : NULL;
+    locationCallback.onRecognitionStarted  = callback->onRecognitionStarted  != NULL ? onRecognitionStarted  : NULL;
+    locationCallback.onRecognitionFinished = callback->onRecognitionFinished != NULL ? onRecognitionFinished : NULL;
+    locationCallback.onGlare               = callback->onGlare               != NULL ? onGlare               : NULL;
+    locationCallback.onShowImage           = callback->onShowImage           != NULL ? onShowImage           : NULL;
+    locationCallback.showImageTypes        = callback->showImageTypes;
+    locationCallback.onFirstSideResult     = callback->onFirstSideResult     != NULL ? onFirstSideResult     : NULL;
+
+    collector.location     = location;
+    collector.userCallback = callback;
+    collector.imageWidth   = image != NULL ? recognizerImageGetWidth( image )  : 0;
+    collector.imageHeight  = image != NULL ? recognizerImageGetHeight( image ) : 0;
+
+    state = recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, image, imageIsVideoFrame, &locationCallback );
+
+    /* symbol that was detected but not decoded must not be used, i.e. for locking a tracker or blanking */
+    if ( state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+    {
+        memset( location, 0, sizeof( MBBarcodeLocation ) );
+    }
+
+    return state;
+}
+
+/* bounding box extended with margin and clamped to the image, in pixels */
+static void marginBox( MBBarcodeLocation const * location, int imageWidth, int imageHeight, float margin, int * left, int * top, int * right, int * bottom )
+{
+    int larger = location->symbolSize.width > location->symbolSize.height ? location->symbolSize.width : location->symbolSize.height;
+    int extra  = margin > 0.f ? ( int ) ( margin * larger + .5f ) : 0;
+
+    *left   = clamp( ( int ) location->boundingBox.x - extra, 0, imageWidth );
+    *top    = clamp( ( int ) location->boundingBox.y - extra, 0, imageHeight );
+    *right  = clamp( ( int ) ( location->boundingBox.x + location->boundingBox.width  ) + extra, 0, imageWidth );
+    *bottom = clamp( ( int ) ( location->boundingBox.y + location->boundingBox.height ) + extra, 0, imageHeight );
+}
+
+MBRecognizerErrorStatus barcodeLocationCreateImageView( MBRecognizerImage ** view, MBRecognizerImage const * image, MBBarcodeLocation const * location, float margin )
+{
+    int left, top, right, bottom;
+
+    if ( view == NULL || image == NULL || location == NULL || !location->found )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    marginBox( location, recognizerImageGetWidth( image ), recognizerImageGetHeight( image ), margin, &left, &top, &right, &bottom );
+    if ( right <= left || bottom <= top )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    return recognizerImageCreateView( view, image, ( uint16_t ) left, ( uint16_t ) top, ( uint16_t ) ( right - left ), ( uint16_t ) ( bottom - top ) );
+}
+
+MBRecognizerErrorStatus barcodeLocationRegionOfInterest( MBRectangle * regionOfInterest, MBBarcodeLocation const * location, int imageWidth, int imageHeight, float margin )
+{
+    int left, top, right, bottom;
+
+    if ( regionOfInterest == NULL || location == NULL || !location->found || imageWidth <= 0 || imageHeight <= 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    marginBox( location, imageWidth, imageHeight, margin, &left, &top, &right, &bottom );
+
+    regionOfInterest->x      = ( float ) left / imageWidth;
+    regionOfInterest->y      = ( float ) top / imageHeight;
+    regionOfInterest->width  = ( float ) ( right - left ) / imageWidth;
+    regionOfInterest->height = ( float ) ( bottom - top ) / imageHeight;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
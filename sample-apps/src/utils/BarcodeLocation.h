@@ -0,0 +1,118 @@
+/**
+ * @file BarcodeLocation.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef BARCODE_LOCATION_H_
+#define BARCODE_LOCATION_H_
+
+#include "UserDataRecognitionCallback.h"
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+#include <Recognizer/Rectangle.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum number of points of the detected symbol stored in MBBarcodeLocation. */
+#define MB_BARCODE_LOCATION_MAX_POINTS 8
+
+/**
+ * @struct MBBarcodeLocation
+ * @brief Location of the symbol that was successfully detected during the last recognition.
+ * All coordinates are in the coordinate system of the recognized image.
+ */
+struct MBBarcodeLocation
+{
+    /** MB_TRUE if the symbol was successfully detected and recognized. If MB_FALSE, all other members are zero. */
+    MBBool found;
+
+    /** Number of valid points in points array. Usually 4 corners of the symbol, in clockwise order. */
+    size_t pointsSize;
+
+    /** Points that outline the detected symbol. */
+    MBPoint points[ MB_BARCODE_LOCATION_MAX_POINTS ];
+
+    /** Smallest axis-aligned rectangle containing all points, clamped to the image, in pixels. */
+    MBRectangle boundingBox;
+
+    /**
+     * Dimensions of the symbol itself, in pixels: for quadrilaterals average lengths of the opposite sides, which
+     * unlike boundingBox do not depend on rotation of the symbol. Equal to boundingBox dimensions for other shapes.
+     */
+    MBSize symbolSize;
+};
+
+/**
+ * @brief Typedef for MBBarcodeLocation structure.
+ */
+typedef struct MBBarcodeLocation MBBarcodeLocation;
+
+/**
+ * @brief Performs recognition of the image and obtains location of the recognized symbol.
+ *
+ * Only onDetectedObject event is registered for obtaining the location, so no other callbacks are added to the
+ * recognition. Location is reported only for a successful detection that was accepted by the user's onDetectedObject,
+ * and only if the recognition returned a non-empty result, so that a symbol which was detected but could not be
+ * decoded is never reported. If multiple detections succeed during the call, location of the last one is reported.
+ *
+ * @param recognizerRunner  Recognizer runner that will perform recognition.
+ * @param image             Image that will be recognized.
+ * @param imageIsVideoFrame Whether the image is video frame.
+ * @param callback          Callbacks of the user, forwarded unchanged, or NULL.
+ * @param location          Receives location of the detected symbol.
+ * @return state of the recognition result.
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithLocation
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback,
+    MBBarcodeLocation                   * location
+);
+
+/**
+ * @brief Creates zero-copy view of the image containing only the detected symbol, i.e. for storing the barcode region
+ * instead of the whole page. @see ::recognizerImageCreateView
+ * @param view      Pointer to pointer referencing the created view.
+ * @param image     Image on which the symbol was detected.
+ * @param location  Location of the detected symbol.
+ * @param margin    Margin added to every side of the bounding box, relative to the larger dimension of the symbol.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if symbol was not found.
+ */
+MBRecognizerErrorStatus barcodeLocationCreateImageView( MBRecognizerImage ** view, MBRecognizerImage const * image, MBBarcodeLocation const * location, float margin );
+
+/**
+ * @brief Computes region of interest containing the detected symbol, suitable for ::recognizerRunnerSetROI when
+ * scanning subsequent pages of the same template.
+ * @param regionOfInterest  Receives relative region of interest.
+ * @param location          Location of the detected symbol.
+ * @param imageWidth        Width of the image on which the symbol was detected.
+ * @param imageHeight       Height of the image on which the symbol was detected.
+ * @param margin            Margin added to every side of the bounding box, relative to the larger dimension of the symbol.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if symbol was not found.
+ */
+MBRecognizerErrorStatus barcodeLocationRegionOfInterest( MBRectangle * regionOfInterest, MBBarcodeLocation const * location, int imageWidth, int imageHeight, float margin );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "BarcodeTracker.h"
+#include "RecognizerImageUtils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_WINDOW_MARGIN     0.5f
+#define DEFAULT_MAX_MISSED_FRAMES 2
+
+struct MBBarcodeTracker
+{
+    MBBarcodeTrackerSettings settings;
+
+    /* last known location, in frame coordinates */
+    MBBarcodeLocation        location;
+    unsigned                 missedFrames;
+
+    /* dimensions of the search window, fixed while the symbol is being tracked */
+    int                      windowWidth;
+    int                      windowHeight;
+
+    /* dimensions of the image last given to the runner, zero if the runner has not been used since the reset */
+    int                      inputWidth;
+    int                      inputHeight;
+
+    MBBarcodeTrackerStats    stats;
+};
+
+void barcodeTrackerSettingsDefaultInit( MBBarcodeTrackerSettings * settings )
+{
+    settings->windowMargin    = DEFAULT_WINDOW_MARGIN;
+    settings->maxMissedFrames = DEFAULT_MAX_MISSED_FRAMES;
+}
+
+MBRecognizerErrorStatus barcodeTrackerCreate( MBBarcodeTracker ** tracker, MBBarcodeTrackerSettings const * settings )
+{
+    if ( tracker == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *tracker = ( MBBarcodeTracker * ) calloc( 1, sizeof( MBBarcodeTracker ) );
+    if ( *tracker == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    if ( settings != NULL )
+    {
+        ( *tracker )->settings = *settings;
+    }
+    else
+    {
+        barcodeTrackerSettingsDefaultInit( &( *tracker )->settings );
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static int clamp( int value, int minimum, int maximum )
+{
+    return value < minimum ? minimum : value > maximum ? maximum : value;
+}
+
+static void translateLocation( MBBarcodeLocation * location, int dx, int dy )
+{
+    size_t i;
+
+    for ( i = 0; i < location->pointsSize; ++i )
+    {
+        location->points[ i ].x += dx;
+        location->points[ i ].y += dy;
+    }
+    location->boundingBox.x += ( float ) dx;
+    location->boundingBox.y += ( float ) dy;
+}
+
+/* starts tracking the symbol found in the whole frame */
+static void lock( MBBarcodeTracker * tracker, MBBarcodeLocation const * location, int frameWidth, int frameHeight )
+{
+    int larger = location->symbolSize.width > location->symbolSize.height ? location->symbolSize.width : location->symbolSize.height;
+    int extra  = ( int ) ( tracker->settings.windowMargin * larger + .5f );
+
+    tracker->location     = *location;
+    tracker->missedFrames = 0;
+    tracker->windowWidth  = clamp( ( int ) location->boundingBox.width  + 2 * extra, 1, frameWidth  );
+    tracker->windowHeight = clamp( ( int ) location->boundingBox.height + 2 * extra, 1, frameHeight );
+}
+
+/* creates view of the given frame centered on the last known location */
+static MBRecognizerErrorStatus createWindow( MBBarcodeTracker const * tracker, MBRecognizerImage const * frame, MBRecognizerImage ** window, int * x, int * y )
+{
+    int frameWidth  = recognizerImageGetWidth( frame );
+    int frameHeight = recognizerImageGetHeight( frame );
+    int centerX     = ( int ) ( tracker->location.boundingBox.x + tracker->location.boundingBox.width  / 2.f );
+    int centerY     = ( int ) ( tracker->location.boundingBox.y + tracker->location.boundingBox.height / 2.f );
+
+    if ( tracker->windowWidth > frameWidth || tracker->windowHeight > frameHeight )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *x = clamp( centerX - tracker->windowWidth  / 2, 0, frameWidth  - tracker->windowWidth  );
+    *y = clamp( centerY - tracker->windowHeight / 2, 0, frameHeight - tracker->windowHeight );
+
+    return recognizerImageCreateView( window, frame, ( uint16_t ) *x, ( uint16_t ) *y, ( uint16_t ) tracker->windowWidth, ( uint16_t ) tracker->windowHeight );
+}
+
+/*
+ * window and the whole frame have different dimensions and coordinate systems, so the runner must not combine them as
+ * consecutive video frames; only windows of the same size, which follow the same symbol, are combined
+ */
+static MBRecognizerResultState recognize
+(
+    MBBarcodeTracker                    * tracker,
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBUserDataRecognitionCallback const * callback,
+    MBBarcodeLocation                   * location
+)
+{
+    int width  = recognizerImageGetWidth( image );
+    int height = recognizerImageGetHeight( image );
+
+    if ( width != tracker->inputWidth || height != tracker->inputHeight )
+    {
+        recognizerRunnerReset( recognizerRunner );
+        tracker->inputWidth  = width;
+        tracker->inputHeight = height;
+    }
+
+    return recognizerRunnerRecognizeFromImageWithLocation( recognizerRunner, image, MB_TRUE, callback, location );
+}
+
+MBRecognizerResultState barcodeTrackerRecognizeFrame
+(
+    MBBarcodeTracker                    * tracker,
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * frame,
+    MBUserDataRecognitionCallback const * callback
+)
+{
+    MBRecognizerResultState state;
+    MBBarcodeLocation       location;
+
+    if ( tracker == NULL || frame == NULL )
+    {
+        return recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, frame, MB_TRUE, callback );
+    }
+
+    if ( tracker->location.found )
+    {
+        MBRecognizerImage * window;
+        int                 x, y;
+
+        if ( createWindow( tracker, frame, &window, &x, &y ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            state = recognize( tracker, recognizerRunner, window, callback, &location );
+            recognizerImageDelete( &window );
+            ++tracker->stats.windowFrames;
+
+            if ( location.found )
+            {
+                translateLocation( &location, x, y );
+                tracker->location     = location;
+                tracker->missedFrames = 0;
+            }
+            else if ( ++tracker->missedFrames > tracker->settings.maxMissedFrames )
+            {
+                /* frame was already given to the runner, so the whole frame is searched from the next frame on */
+                ++tracker->stats.trackingLost;
+                memset( &tracker->location, 0, sizeof( MBBarcodeLocation ) );
+            }
+            return state;
+        }
+
+        /* frame cannot be viewed, i.e. its size has changed */
+        ++tracker->stats.trackingLost;
+        memset( &tracker->location, 0, sizeof( MBBarcodeLocation ) );
+    }
+
+    state = recognize( tracker, recognizerRunner, frame, callback, &location );
+    ++tracker->stats.fullFrames;
+
+    /* NV21 frames cannot be viewed, so there is no point in tracking */
+    if ( location.found && recognizerImageRawTypeBytesPerPixel( recognizerImageGetRawImageType( frame ) ) > 0 )
+    {
+        lock( tracker, &location, recognizerImageGetWidth( frame ), recognizerImageGetHeight( frame ) );
+    }
+
+    return state;
+}
+
+MBBarcodeLocation const * barcodeTrackerLocation( MBBarcodeTracker const * tracker )
+{
+    return tracker != NULL ? &tracker->location : NULL;
+}
+
+MBRecognizerErrorStatus barcodeTrackerReset( MBBarcodeTracker * tracker )
+{
+    if ( tracker == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    memset( &tracker->location, 0, sizeof( MBBarcodeLocation ) );
+    tracker->missedFrames = 0;
+    tracker->inputWidth   = 0;
+    tracker->inputHeight  = 0;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus barcodeTrackerGetStats( MBBarcodeTrackerStats * stats, MBBarcodeTracker const * tracker )
+{
+    if ( stats == NULL || tracker == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *stats = tracker->stats;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus barcodeTrackerDelete( MBBarcodeTracker ** tracker )
+{
+    if ( tracker == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    free( *tracker );
+    *tracker = NULL;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file BarcodeTracker.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef BARCODE_TRACKER_H_
+#define BARCODE_TRACKER_H_
+
+#include "BarcodeLocation.h"
+#include "UserDataRecognitionCallback.h"
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBBarcodeTrackerSettings
+ * @brief Settings of MBBarcodeTracker.
+ */
+struct MBBarcodeTrackerSettings
+{
+    /**
+     * Margin added to every side of the symbol's bounding box when the search window is established, relative to the
+     * larger dimension of the symbol. Larger margins tolerate faster movement of the symbol between frames.
+     * By default, this is set to 0.5.
+     */
+    float windowMargin;
+
+    /**
+     * Number of consecutive frames in which the symbol may be missing from the search window before tracking is
+     * considered lost and the full frame is searched again. By default, this is set to 2.
+     */
+    unsigned maxMissedFrames;
+};
+
+/**
+ * @brief Typedef for MBBarcodeTrackerSettings structure.
+ */
+typedef struct MBBarcodeTrackerSettings MBBarcodeTrackerSettings;
+
+/**
+ * @memberof MBBarcodeTrackerSettings
+ * @brief Populate MBBarcodeTrackerSettings structure with default values.
+ * @param settings Settings that will be initialized.
+ */
+void barcodeTrackerSettingsDefaultInit( MBBarcodeTrackerSettings * settings );
+
+/**
+ * @struct MBBarcodeTrackerStats
+ * @brief Counters of MBBarcodeTracker, for measuring how much of the video is processed within the search window.
+ */
+struct MBBarcodeTrackerStats
+{
+    /** Number of frames recognized only within the search window. */
+    size_t windowFrames;
+
+    /** Number of frames recognized as a whole. */
+    size_t fullFrames;
+
+    /** Number of times the tracking was lost. */
+    size_t trackingLost;
+};
+
+/**
+ * @brief Typedef for MBBarcodeTrackerStats structure.
+ */
+typedef struct MBBarcodeTrackerStats MBBarcodeTrackerStats;
+
+/**
+ * @struct MBBarcodeTracker
+ * @brief Tracks the symbol across consecutive video frames, so that only a small window around its last known
+ * position is recognized instead of the whole frame.
+ *
+ * Window is a zero-copy view of the frame (@see ::recognizerImageCreateView). Its dimensions are fixed when the symbol
+ * is found and only its position follows the symbol, so that the recognizer keeps combining consecutive video frames
+ * of the same size. Recognizer runner is reset whenever the dimensions of the recognized image change, i.e. when
+ * switching between the window and the whole frame, so that images of different geometry are never combined. Frames
+ * of type MB_RAW_IMAGE_TYPE_NV21 cannot be viewed, so they are always recognized as a whole.
+ * Single tracker must be used only with frames of a single video stream and a single recognizer runner.
+ */
+struct MBBarcodeTracker;
+
+/**
+ * @brief Typedef for MBBarcodeTracker structure.
+ */
+typedef struct MBBarcodeTracker MBBarcodeTracker;
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Allocates and initializes new MBBarcodeTracker object.
+ * @param tracker   Pointer to pointer referencing the created object.
+ * @param settings  Settings of the tracker, or NULL for default settings.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus barcodeTrackerCreate( MBBarcodeTracker ** tracker, MBBarcodeTrackerSettings const * settings );
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Recognizes the given video frame, within the search window if the symbol is being tracked.
+ *
+ * If the symbol is missing from the window for more than maxMissedFrames consecutive frames, tracking is lost and the
+ * next frame is recognized as a whole. The same frame is never given to the recognizer runner twice.
+ *
+ * @param tracker           Tracker of interest.
+ * @param recognizerRunner  Recognizer runner that will perform recognition.
+ * @param frame             Video frame that will be recognized.
+ * @param callback          Callbacks of the user, or NULL. Note that points given to callbacks are relative to the
+ *                          recognized image, i.e. to the search window while the symbol is being tracked.
+ * @return state of the recognition result.
+ */
+MBRecognizerResultState barcodeTrackerRecognizeFrame
+(
+    MBBarcodeTracker                    * tracker,
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * frame,
+    MBUserDataRecognitionCallback const * callback
+);
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Returns the last known location of the symbol, in the coordinate system of the whole frame.
+ * @param tracker   Tracker of interest.
+ * @return last known location. Its found member is MB_FALSE if the symbol is not being tracked.
+ */
+MBBarcodeLocation const * barcodeTrackerLocation( MBBarcodeTracker const * tracker );
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Stops tracking, so that the next frame is recognized as a whole. Should be called whenever the recognizer
+ * runner is reset, or when the recognizer runner was used for other images in the meantime.
+ * @param tracker   Tracker of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus barcodeTrackerReset( MBBarcodeTracker * tracker );
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Obtains counters of the tracker.
+ * @param stats     Structure that will receive the counters.
+ * @param tracker   Tracker of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus barcodeTrackerGetStats( MBBarcodeTrackerStats * stats, MBBarcodeTracker const * tracker );
+
+/**
+ * @memberof MBBarcodeTracker
+ * @brief Destroys the given MBBarcodeTracker and sets pointer to it to NULL.
+ * @param tracker   Pointer to pointer to MBBarcodeTracker that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus barcodeTrackerDelete( MBBarcodeTracker ** tracker );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "BenchmarkRunner.h"
+#include "LicenseKey.h"
+#include "LocalCacheLocation.h"
+
+#include <Recognizer/Licensing.h>
+#include <Recognizer/RecognizerApiUtils.h>
+
+#include <stdio.h>
+#include <string.h>
+
+MBRecognizerErrorStatus benchmarkRunnerCreate( MBBenchmarkRunner * runner, MBBool slowerThoroughScan, MBBool uncertainDecoding, MBRectangle const * roi )
+{
+    MBCroatiaPdf417PaymentRecognizerSettings pdf417Settings;
+    MBCroatiaQrPaymentRecognizerSettings     qrSettings;
+    MBRecognizerRunnerSettings               runnerSettings;
+    MBRecognizerPtr                          recognizers[ 2 ];
+    MBRecognizerErrorStatus                  status;
+
+    memset( runner, 0, sizeof( MBBenchmarkRunner ) );
+
+    croatiaPdf417PaymentRecognizerSettingsInit( &pdf417Settings );
+    pdf417Settings.uncertainDecoding = uncertainDecoding;
+
+    croatiaQrPaymentRecognizerSettingsInit( &qrSettings );
+    qrSettings.slowerThoroughScan = slowerThoroughScan;
+
+    status = croatiaPdf417PaymentRecognizerCreate( &runner->pdf417Recognizer, &pdf417Settings );
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        status = croatiaQrPaymentRecognizerCreate( &runner->qrRecognizer, &qrSettings );
+    }
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recognizerRunnerSettingsDefaultInit( &runnerSettings );
+        recognizers[ 0 ] = runner->pdf417Recognizer;
+        recognizers[ 1 ] = runner->qrRecognizer;
+        runnerSettings.allowMultipleResults = MB_FALSE;
+        runnerSettings.numOfRecognizers     = 2;
+        runnerSettings.recognizers          = recognizers;
+
+        status = recognizerRunnerCreate( &runner->recognizerRunner, &runnerSettings );
+    }
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS && roi != NULL )
+    {
+        status = recognizerRunnerSetROI( runner->recognizerRunner, roi );
+    }
+
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        benchmarkRunnerDelete( runner );
+    }
+    return status;
+}
+
+void benchmarkRunnerWarmUp( MBBenchmarkRunner const * runner, MBImageCorpus const * corpus, size_t numRecognitions )
+{
+    size_t i;
+
+    for ( i = 0; i < numRecognitions; ++i )
+    {
+        recognizerRunnerRecognizeFromImage( runner->recognizerRunner, corpus->entries[ i % corpus->count ].image, MB_FALSE, NULL );
+    }
+}
+
+void benchmarkRunnerDelete( MBBenchmarkRunner * runner )
+{
+    /* runner must be deleted before the recognizers it uses */
+    recognizerRunnerDelete( &runner->recognizerRunner );
+    croatiaPdf417PaymentRecognizerDelete( &runner->pdf417Recognizer );
+    croatiaQrPaymentRecognizerDelete( &runner->qrRecognizer );
+}
+
+MBRecognizerErrorStatus benchmarkUnlock( char const * applicationName )
+{
+    /* keep license counters on the local disk, even if home folder is mounted over network */
+    if ( localCacheLocationApply( applicationName ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recognizerAPISetCacheLocation( "." );
+    }
+
+#if defined LICENSE_KEY && defined LICENSEE
+    return recognizerAPIUnlockForLicenseeWithLicenseKey( LICENSE_KEY, LICENSEE );
+#else
+    return recognizerAPIUnlockWithLicenseKey( LICENSE_KEY );
+#endif
+}
+
+void benchmarkReportLoadFailure( char const * path, MBRecognizerErrorStatus status, void * userData )
+{
+    ( void ) userData;
+    fprintf( stderr, "Failed to load image '%s'. Reason: %s\n", path, recognizerErrorToString( status ) );
+}
@@ -0,0 +1,111 @@
+/**
+ * @file BenchmarkRunner.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef BENCHMARK_RUNNER_H_
+#define BENCHMARK_RUNNER_H_
+
+#include "ImageCorpus.h"
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerRunner.h>
+#include <Recognizer/Rectangle.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBBenchmarkRunner
+ * @brief Recognizer runner with PDF417 and QR payment recognizers, as measured by photopay-bench and photopay-perfcheck.
+ *
+ * Recognizers are owned by the runner and never shared, so that every thread of a measurement can use its own one.
+ */
+struct MBBenchmarkRunner
+{
+    /** PDF417 payment recognizer used by the runner. */
+    MBCroatiaPdf417PaymentRecognizer * pdf417Recognizer;
+
+    /** QR payment recognizer used by the runner. */
+    MBCroatiaQrPaymentRecognizer     * qrRecognizer;
+
+    /** Runner that recognizes with both recognizers. */
+    MBRecognizerRunner               * recognizerRunner;
+};
+
+/**
+ * @brief Typedef for MBBenchmarkRunner structure.
+ */
+typedef struct MBBenchmarkRunner MBBenchmarkRunner;
+
+/**
+ * @brief Creates the recognizers and the runner, which stops at the first valid result.
+ *
+ * @param runner                Runner that will be created. On failure it is left zeroed.
+ * @param slowerThoroughScan    Value of slowerThoroughScan of the QR recognizer, which is enabled by default.
+ * @param uncertainDecoding     Value of uncertainDecoding of the PDF417 recognizer, which is enabled by default.
+ * @param roi                   Region of interest of the runner, or NULL for the whole image.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus benchmarkRunnerCreate( MBBenchmarkRunner * runner, MBBool slowerThoroughScan, MBBool uncertainDecoding, MBRectangle const * roi );
+
+/**
+ * @brief Recognizes images of the corpus in order, wrapping around, without measuring them.
+ *
+ * First recognitions allocate buffers and load models, which production runners do only once, so they are excluded
+ * from measurements this way.
+ *
+ * @param runner            Runner to warm up.
+ * @param corpus            Corpus with at least one image.
+ * @param numRecognitions   Number of recognitions.
+ */
+void benchmarkRunnerWarmUp( MBBenchmarkRunner const * runner, MBImageCorpus const * corpus, size_t numRecognitions );
+
+/**
+ * @brief Deletes the runner and its recognizers, and zeroes it.
+ *
+ * @param runner    Runner created with ::benchmarkRunnerCreate, or zeroed.
+ */
+void benchmarkRunnerDelete( MBBenchmarkRunner * runner );
+
+/**
+ * @brief Unlocks the SDK with the license key from LicenseKey.h, keeping license counters on the local disk.
+ *
+ * Cache location is chosen with ::localCacheLocationApply, falling back to the current folder when the local one cannot
+ * be used.
+ *
+ * @param applicationName   Name of the folder of the application within the local cache folder.
+ * @return status of the unlock.
+ */
+MBRecognizerErrorStatus benchmarkUnlock( char const * applicationName );
+
+/**
+ * @brief MBImageCorpusLoadFailed that prints the image that cannot be loaded to standard error.
+ *
+ * Such images are skipped, so that a single damaged file does not stop the measurement.
+ *
+ * @param path      Path of the image.
+ * @param status    Status of loading the image.
+ * @param userData  Unused.
+ */
+void benchmarkReportLoadFailure( char const * path, MBRecognizerErrorStatus status, void * userData );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentFieldConfidence.h"
+#include "CroatiaPaymentValidation.h"
+
+#include <string.h>
+
+#define PURPOSE_CODE_LENGTH     4
+
+/* positions of bank code and account number within Croatian IBAN */
+#define BANK_CODE_OFFSET        4
+#define BANK_CODE_LENGTH        7
+#define ACCOUNT_NUMBER_OFFSET   11
+#define ACCOUNT_NUMBER_LENGTH   10
+
+static int isEmpty( char const * string )
+{
+    return string == NULL || string[ 0 ] == '\0';
+}
+
+/* text fields have no format, but control characters in them are a sign of misread data */
+static MBCroatiaPaymentFieldConfidence textConfidence( char const * text )
+{
+    unsigned char const * c;
+
+    if ( isEmpty( text ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    for ( c = ( unsigned char const * ) text; *c != '\0'; ++c )
+    {
+        if ( *c < 0x20 || *c == 0x7F )
+        {
+            return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+        }
+    }
+
+    return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_UNVERIFIED;
+}
+
+static MBCroatiaPaymentFieldConfidence amountConfidence( MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    if ( result->amountEur == 0 && result->amountHrk == 0 )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    if ( result->amountEur < 0 || result->amountHrk < 0 || ( result->conversionToEurPerformed && result->amountHrk == 0 ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+    }
+
+    /* amount has no checksum */
+    return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_UNVERIFIED;
+}
+
+/* bank code and account number are either extracted from IBAN, or given separately on HUB1 slips */
+static MBCroatiaPaymentFieldConfidence ibanPartConfidence( char const * part, size_t length, char const * iban, size_t offset )
+{
+    size_t i;
+
+    if ( isEmpty( part ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    for ( i = 0; part[ i ] != '\0'; ++i )
+    {
+        if ( part[ i ] < '0' || part[ i ] > '9' )
+        {
+            return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+        }
+    }
+
+    if ( i == length && ibanIsValid( iban ) && iban[ 0 ] == 'H' && iban[ 1 ] == 'R' && memcmp( iban + offset, part, length ) == 0 )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID;
+    }
+
+    return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_UNVERIFIED;
+}
+
+static MBCroatiaPaymentFieldConfidence ibanConfidence( char const * iban )
+{
+    if ( isEmpty( iban ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    return ibanIsValid( iban ) ? MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID : MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+}
+
+static MBCroatiaPaymentFieldConfidence referenceModelConfidence( char const * referenceModel )
+{
+    if ( isEmpty( referenceModel ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    return croatiaReferenceIsValid( referenceModel, NULL ) ? MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID : MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+}
+
+static MBCroatiaPaymentFieldConfidence referenceConfidence( char const * referenceModel, char const * reference )
+{
+    MBBool valid = croatiaReferenceIsValid( referenceModel, reference );
+
+    /* empty reference is correct only for model HR99 */
+    if ( isEmpty( reference ) )
+    {
+        return valid && strcmp( referenceModel, "HR99" ) == 0 ? MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID : MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    return valid ? MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID : MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+}
+
+static MBCroatiaPaymentFieldConfidence purposeCodeConfidence( char const * purposeCode )
+{
+    size_t i;
+
+    if ( isEmpty( purposeCode ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    /* ISO 20022 purpose codes consist of four uppercase letters */
+    for ( i = 0; i < PURPOSE_CODE_LENGTH; ++i )
+    {
+        if ( purposeCode[ i ] < 'A' || purposeCode[ i ] > 'Z' )
+        {
+            return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+        }
+    }
+
+    return purposeCode[ PURPOSE_CODE_LENGTH ] == '\0' ? MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID : MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+}
+
+static MBCroatiaPaymentFieldConfidence dueDateConfidence( MBDate const * date )
+{
+    if ( date->empty && isEmpty( date->originalString ) )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING;
+    }
+
+    if ( !date->successfullyParsed || date->day < 1 || date->day > 31 || date->month < 1 || date->month > 12 )
+    {
+        return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID;
+    }
+
+    return MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID;
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultFieldConfidences( MBCroatiaPaymentFieldConfidences * confidences, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    MBCroatiaPaymentFieldConfidence * fields;
+
+    if ( confidences == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    fields = confidences->fields;
+
+    fields[ MB_CROATIA_PAYMENT_FIELD_AMOUNT                     ] = amountConfidence( result );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PAYER_NAME                 ] = textConfidence( result->payerName );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PAYER_ADDRESS              ] = textConfidence( result->payerAddress );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PAYER_DETAILED_ADDRESS     ] = textConfidence( result->payerDetailedAddress );
+    fields[ MB_CROATIA_PAYMENT_FIELD_RECIPIENT_NAME             ] = textConfidence( result->recipientName );
+    fields[ MB_CROATIA_PAYMENT_FIELD_RECIPIENT_ADDRESS          ] = textConfidence( result->recipientAddress );
+    fields[ MB_CROATIA_PAYMENT_FIELD_RECIPIENT_DETAILED_ADDRESS ] = textConfidence( result->recipientDetailedAddress );
+    fields[ MB_CROATIA_PAYMENT_FIELD_ACCOUNT_NUMBER             ] = ibanPartConfidence( result->accountNumber, ACCOUNT_NUMBER_LENGTH, result->iban, ACCOUNT_NUMBER_OFFSET );
+    fields[ MB_CROATIA_PAYMENT_FIELD_BANK_CODE                  ] = ibanPartConfidence( result->bankCode, BANK_CODE_LENGTH, result->iban, BANK_CODE_OFFSET );
+    fields[ MB_CROATIA_PAYMENT_FIELD_IBAN                       ] = ibanConfidence( result->iban );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PURPOSE_CODE               ] = purposeCodeConfidence( result->purposeCode );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PAYMENT_DESCRIPTION        ] = textConfidence( result->paymentDescription );
+    fields[ MB_CROATIA_PAYMENT_FIELD_PAYMENT_DESCRIPTION_CODE   ] = textConfidence( result->paymentDescriptionCode );
+    fields[ MB_CROATIA_PAYMENT_FIELD_DUE_DATE                   ] = dueDateConfidence( &result->dueDate );
+
+    if ( result->slipId == MB_CROATIA_PAYMENT_BARCODE_TYPE_HUB3 )
+    {
+        fields[ MB_CROATIA_PAYMENT_FIELD_REFERENCE_MODEL ] = referenceModelConfidence( result->referenceModel );
+        fields[ MB_CROATIA_PAYMENT_FIELD_REFERENCE       ] = referenceConfidence( result->referenceModel, result->reference );
+    }
+    else
+    {
+        /* HUB1 reference models are not defined by HUB3 standard */
+        fields[ MB_CROATIA_PAYMENT_FIELD_REFERENCE_MODEL ] = textConfidence( result->referenceModel );
+        fields[ MB_CROATIA_PAYMENT_FIELD_REFERENCE       ] = textConfidence( result->reference );
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+unsigned croatiaPaymentFieldConfidencesWeakFields( MBCroatiaPaymentFieldConfidences const * confidences, unsigned fieldMask )
+{
+    unsigned weakFields = 0;
+    int      field;
+
+    if ( confidences == NULL )
+    {
+        return fieldMask;
+    }
+
+    for ( field = 0; field < MB_CROATIA_PAYMENT_FIELD_COUNT; ++field )
+    {
+        if ( confidences->fields[ field ] <= MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID )
+        {
+            weakFields |= MB_CROATIA_PAYMENT_FIELD_BIT( field );
+        }
+    }
+
+    return weakFields & fieldMask;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file CroatiaPaymentFieldConfidence.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_FIELD_CONFIDENCE_H_
+#define CROATIA_PAYMENT_FIELD_CONFIDENCE_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @enum MBCroatiaPaymentField
+ * @brief Fields of MBCroatiaBarcodePaymentRecognizerResult whose confidence is reported.
+ */
+enum MBCroatiaPaymentField
+{
+    /** amountHrk and amountEur */
+    MB_CROATIA_PAYMENT_FIELD_AMOUNT = 0,
+    MB_CROATIA_PAYMENT_FIELD_PAYER_NAME,
+    MB_CROATIA_PAYMENT_FIELD_PAYER_ADDRESS,
+    MB_CROATIA_PAYMENT_FIELD_PAYER_DETAILED_ADDRESS,
+    MB_CROATIA_PAYMENT_FIELD_RECIPIENT_NAME,
+    MB_CROATIA_PAYMENT_FIELD_RECIPIENT_ADDRESS,
+    MB_CROATIA_PAYMENT_FIELD_RECIPIENT_DETAILED_ADDRESS,
+    MB_CROATIA_PAYMENT_FIELD_ACCOUNT_NUMBER,
+    MB_CROATIA_PAYMENT_FIELD_BANK_CODE,
+    MB_CROATIA_PAYMENT_FIELD_IBAN,
+    MB_CROATIA_PAYMENT_FIELD_REFERENCE_MODEL,
+    MB_CROATIA_PAYMENT_FIELD_REFERENCE,
+    MB_CROATIA_PAYMENT_FIELD_PURPOSE_CODE,
+    MB_CROATIA_PAYMENT_FIELD_PAYMENT_DESCRIPTION,
+    MB_CROATIA_PAYMENT_FIELD_PAYMENT_DESCRIPTION_CODE,
+    MB_CROATIA_PAYMENT_FIELD_DUE_DATE,
+
+    /** Number of fields, not a field. */
+    MB_CROATIA_PAYMENT_FIELD_COUNT
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentField enum.
+ */
+typedef enum MBCroatiaPaymentField MBCroatiaPaymentField;
+
+/** Bit of the given MBCroatiaPaymentField in field masks. */
+#define MB_CROATIA_PAYMENT_FIELD_BIT( field ) ( 1u << ( field ) )
+
+/** Fields whose errors make the payment go to the wrong account or with the wrong amount. */
+#define MB_CROATIA_PAYMENT_CRITICAL_FIELDS                                      \
+    ( MB_CROATIA_PAYMENT_FIELD_BIT( MB_CROATIA_PAYMENT_FIELD_AMOUNT          ) | \
+      MB_CROATIA_PAYMENT_FIELD_BIT( MB_CROATIA_PAYMENT_FIELD_IBAN            ) | \
+      MB_CROATIA_PAYMENT_FIELD_BIT( MB_CROATIA_PAYMENT_FIELD_REFERENCE_MODEL ) | \
+      MB_CROATIA_PAYMENT_FIELD_BIT( MB_CROATIA_PAYMENT_FIELD_REFERENCE       ) )
+
+/**
+ * @enum MBCroatiaPaymentFieldConfidence
+ * @brief Confidence of a single field, from the weakest to the strongest.
+ */
+enum MBCroatiaPaymentFieldConfidence
+{
+    /** Field is empty. */
+    MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_MISSING = 0,
+
+    /** Field is present, but violates its format or checksum, so it was most probably misread. */
+    MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_INVALID,
+
+    /** Field is present and contains only printable characters, but has no format or checksum that could be verified. */
+    MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_UNVERIFIED,
+
+    /** Field passes all format and checksum checks defined for it. */
+    MB_CROATIA_PAYMENT_FIELD_CONFIDENCE_VALID
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentFieldConfidence enum.
+ */
+typedef enum MBCroatiaPaymentFieldConfidence MBCroatiaPaymentFieldConfidence;
+
+/**
+ * @struct MBCroatiaPaymentFieldConfidences
+ * @brief Confidences of all fields of a single result.
+ */
+struct MBCroatiaPaymentFieldConfidences
+{
+    /** Confidence of each field, indexed by MBCroatiaPaymentField. */
+    MBCroatiaPaymentFieldConfidence fields[ MB_CROATIA_PAYMENT_FIELD_COUNT ];
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentFieldConfidences structure.
+ */
+typedef struct MBCroatiaPaymentFieldConfidences MBCroatiaPaymentFieldConfidences;
+
+/**
+ * @brief Computes confidence of every field of the given result.
+ *
+ * Confidence is derived from the decoded data itself: IBAN checksum, HUB3 reference model syntax, purpose code and
+ * due date format, consistency of bank code and account number with IBAN and absence of control characters in text
+ * fields. This allows re-scanning or manual verification of only those results whose critical fields are weak, instead
+ * of all results marked as uncertain.
+ *
+ * Example:
+ * @code
+ *  MBCroatiaPaymentFieldConfidences confidences;
+ *
+ *  croatiaPaymentResultFieldConfidences( &confidences, &result );
+ *  if ( croatiaPaymentFieldConfidencesWeakFields( &confidences, MB_CROATIA_PAYMENT_CRITICAL_FIELDS ) != 0 ) {
+ *      // send for thorough pass or manual verification
+ *  }
+ * @endcode
+ *
+ * @param confidences   Structure that will receive the confidences.
+ * @param result        Result obtained from MBCroatiaPdf417PaymentRecognizer, MBCroatiaQrPaymentRecognizer or MBCroatiaPaymentPayloadParser.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultFieldConfidences( MBCroatiaPaymentFieldConfidences * confidences, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @brief Finds weak fields, i.e. fields which are either missing or invalid.
+ * @param confidences   Confidences obtained with ::croatiaPaymentResultFieldConfidences.
+ * @param fieldMask     Mask of fields of interest, built with MB_CROATIA_PAYMENT_FIELD_BIT.
+ * @return mask of fields of interest that are weak, 0 if all are either valid or unverified.
+ */
+unsigned croatiaPaymentFieldConfidencesWeakFields( MBCroatiaPaymentFieldConfidences const * confidences, unsigned fieldMask );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentMultiResult.h"
+#include "CroatiaPaymentResultUtils.h"
+#include "RecognizerImageUtils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* margin around found symbol that is blanked out, relative to the symbol's larger dimension */
+#define BLANK_MARGIN 0.1f
+
+/* value of blanked bytes, i.e. white in all supported raw image types */
+#define BLANK_VALUE 0xFF
+
+struct MBCroatiaPaymentMultiResult
+{
+    size_t                            count;
+    size_t                            capacity;
+    MBCroatiaDetachedPaymentResult ** results;
+    MBBarcodeLocation               * locations;
+};
+
+static void addResult( MBCroatiaPaymentMultiResult * results, MBCroatiaBarcodePaymentRecognizerResult const * result, MBBarcodeLocation const * location )
+{
+    size_t i;
+
+    if ( results->count == results->capacity )
+    {
+        return;
+    }
+
+    for ( i = 0; i < results->count; ++i )
+    {
+        /* the same symbol may be reported by more than one pass if blanking did not cover it completely */
+        if ( croatiaPaymentResultEqual( croatiaDetachedPaymentResultGet( results->results[ i ] ), result ) )
+        {
+            return;
+        }
+    }
+
+    if ( croatiaPaymentResultDetach( &results->results[ results->count ], result ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        results->locations[ results->count ] = *location;
+        ++results->count;
+    }
+}
+
+/* fetches result of the recognizer, which may be NULL; MB_FALSE if there is no result */
+static MBBool pdf417Result( MBCroatiaBarcodePaymentRecognizerResult * result, MBCroatiaPdf417PaymentRecognizer const * recognizer )
+{
+    return recognizer != NULL &&
+           croatiaPdf417PaymentRecognizerResult( result, recognizer ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS &&
+           result->baseResult.state != MB_RECOGNIZER_RESULT_STATE_EMPTY;
+}
+
+/* fetches result of the recognizer, which may be NULL; MB_FALSE if there is no result */
+static MBBool qrResult( MBCroatiaBarcodePaymentRecognizerResult * result, MBCroatiaQrPaymentRecognizer const * recognizer )
+{
+    return recognizer != NULL &&
+           croatiaQrPaymentRecognizerResult( result, recognizer ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS &&
+           result->baseResult.state != MB_RECOGNIZER_RESULT_STATE_EMPTY;
+}
+
+static void blank( MBByte * pixels, MBRecognizerImage const * image, int bytesPerPixel, MBBarcodeLocation const * location )
+{
+    MBRectangle region;
+    int         imageWidth  = recognizerImageGetWidth( image );
+    int         imageHeight = recognizerImageGetHeight( image );
+    size_t      bytesPerRow = recognizerImageGetBytesPerRow( image );
+    int         left, top, width, height, row;
+
+    if ( barcodeLocationRegionOfInterest( &region, location, imageWidth, imageHeight, BLANK_MARGIN ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return;
+    }
+
+    left   = ( int ) ( region.x      * imageWidth  + .5f );
+    top    = ( int ) ( region.y      * imageHeight + .5f );
+    width  = ( int ) ( region.width  * imageWidth  + .5f );
+    height = ( int ) ( region.height * imageHeight + .5f );
+
+    if ( left + width > imageWidth )
+    {
+        width = imageWidth - left;
+    }
+
+    for ( row = top; row < top + height && row < imageHeight; ++row )
+    {
+        memset( pixels + row * bytesPerRow + ( size_t ) left * bytesPerPixel, BLANK_VALUE, ( size_t ) width * bytesPerPixel );
+    }
+}
+
+/* MB_TRUE if the result was produced again and is the same as the detached one */
+static MBBool sameResult( MBCroatiaDetachedPaymentResult const * expected, MBCroatiaBarcodePaymentRecognizerResult const * result, MBBool hasResult )
+{
+    return expected != NULL && hasResult && croatiaPaymentResultEqual( croatiaDetachedPaymentResultGet( expected ), result );
+}
+
+/*
+ * recognizes only the region of the location, and keeps each of the given results only if the same result is decoded
+ * inside it; results are replaced by the ones of the region, because recognition reuses the memory of the previous ones
+ */
+static MBRecognizerErrorStatus confirmResults
+(
+    MBRecognizerRunner                           * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer       const * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer           const * qrRecognizer,
+    MBRecognizerImage                      const * image,
+    MBBarcodeLocation                      const * location,
+    MBCroatiaBarcodePaymentRecognizerResult      * pdf417,
+    MBBool                                       * hasPdf417,
+    MBCroatiaBarcodePaymentRecognizerResult      * qr,
+    MBBool                                       * hasQr
+)
+{
+    MBCroatiaDetachedPaymentResult * expectedPdf417 = NULL;
+    MBCroatiaDetachedPaymentResult * expectedQr     = NULL;
+    MBRecognizerImage              * view;
+    MBRecognizerErrorStatus          status         = MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+
+    if ( *hasPdf417 )
+    {
+        status = croatiaPaymentResultDetach( &expectedPdf417, pdf417 );
+    }
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS && *hasQr )
+    {
+        status = croatiaPaymentResultDetach( &expectedQr, qr );
+    }
+
+    *hasPdf417 = *hasQr = MB_FALSE;
+
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS &&
+         barcodeLocationCreateImageView( &view, image, location, BLANK_MARGIN ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recognizerRunnerReset( recognizerRunner );
+        recognizerRunnerRecognizeFromImage( recognizerRunner, view, MB_FALSE, NULL );
+        recognizerImageDelete( &view );
+
+        *hasPdf417 = sameResult( expectedPdf417, pdf417, pdf417Result( pdf417, pdf417Recognizer ) );
+        *hasQr     = sameResult( expectedQr,     qr,     qrResult( qr, qrRecognizer ) );
+    }
+
+    croatiaDetachedPaymentResultDelete( &expectedPdf417 );
+    croatiaDetachedPaymentResultDelete( &expectedQr );
+
+    return status;
+}
+
+MBRecognizerErrorStatus croatiaPaymentMultiResultRecognize
+(
+    MBCroatiaPaymentMultiResult            ** results,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    size_t                                    maxResults
+)
+{
+    MBCroatiaPaymentMultiResult * multiResult;
+    MBRecognizerImage           * copy = NULL;
+    MBByte                      * pixels;
+    MBRecognizerErrorStatus       status;
+    uint16_t                      bytesPerRow;
+    int                           bytesPerPixel;
+    size_t                        pass, maxPasses;
+
+    if ( results == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+    *results = NULL;
+
+    if ( recognizerRunner == NULL || image == NULL || ( pdf417Recognizer == NULL && qrRecognizer == NULL ) || maxResults == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    bytesPerPixel = recognizerImageRawTypeBytesPerPixel( recognizerImageGetRawImageType( image ) );
+    if ( bytesPerPixel == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_NOT_SUPPORTED;
+    }
+
+    multiResult = ( MBCroatiaPaymentMultiResult * ) calloc( 1, sizeof( MBCroatiaPaymentMultiResult ) );
+    if ( multiResult == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+    multiResult->capacity  = maxResults;
+    multiResult->results   = ( MBCroatiaDetachedPaymentResult ** ) calloc( maxResults, sizeof( MBCroatiaDetachedPaymentResult * ) );
+    multiResult->locations = ( MBBarcodeLocation * ) calloc( maxResults, sizeof( MBBarcodeLocation ) );
+
+    bytesPerRow = recognizerImageGetBytesPerRow( image );
+    pixels      = ( MBByte * ) malloc( ( size_t ) bytesPerRow * recognizerImageGetHeight( image ) );
+
+    if ( multiResult->results == NULL || multiResult->locations == NULL || pixels == NULL )
+    {
+        free( pixels );
+        croatiaPaymentMultiResultDelete( &multiResult );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    memcpy( pixels, recognizerImageGetRawBytes( image ), ( size_t ) bytesPerRow * recognizerImageGetHeight( image ) );
+    status = recognizerImageCreateFromRawImage( &copy, pixels, recognizerImageGetWidth( image ), recognizerImageGetHeight( image ), bytesPerRow, recognizerImageGetRawImageType( image ) );
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        status = recognizerImageSetImageOrientation( copy, recognizerImageGetImageOrientation( image ) );
+    }
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        if ( copy != NULL )
+        {
+            recognizerImageDelete( &copy );
+        }
+        free( pixels );
+        croatiaPaymentMultiResultDelete( &multiResult );
+        return status;
+    }
+
+    /* every pass blanks one symbol; the bound protects against symbols that keep being detected after blanking */
+    maxPasses = 2 * maxResults + 1;
+    for ( pass = 0; pass < maxPasses && multiResult->count < maxResults; ++pass )
+    {
+        MBBarcodeLocation                       location;
+        MBCroatiaBarcodePaymentRecognizerResult pdf417;
+        MBCroatiaBarcodePaymentRecognizerResult qr;
+        MBBool                                  hasPdf417, hasQr;
+
+        recognizerRunnerReset( recognizerRunner );
+        recognizerRunnerRecognizeFromImageWithLocation( recognizerRunner, copy, MB_FALSE, NULL, &location );
+        if ( !location.found )
+        {
+            break;
+        }
+
+        hasPdf417 = pdf417Result( &pdf417, pdf417Recognizer );
+        hasQr     = qrResult( &qr, qrRecognizer );
+
+        /* no recognizer decoded anything, so the detected symbol is undecodable and no other symbol is left */
+        if ( !hasPdf417 && !hasQr )
+        {
+            break;
+        }
+
+        /*
+         * location is the one of the last detection of any recognizer in the chain, which is not necessarily the
+         * symbol that was decoded, so a result is accepted only if it decodes again inside that location
+         */
+        status = confirmResults( recognizerRunner, pdf417Recognizer, qrRecognizer, copy, &location, &pdf417, &hasPdf417, &qr, &hasQr );
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            break;
+        }
+
+        /* blanking the region would erase a symbol that was not accepted, so the search ends here */
+        if ( !hasPdf417 && !hasQr )
+        {
+            break;
+        }
+
+        if ( hasPdf417 )
+        {
+            addResult( multiResult, &pdf417, &location );
+        }
+        if ( hasQr )
+        {
+            addResult( multiResult, &qr, &location );
+        }
+
+        blank( pixels, copy, bytesPerPixel, &location );
+    }
+
+    recognizerImageDelete( &copy );
+    free( pixels );
+
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        croatiaPaymentMultiResultDelete( &multiResult );
+        return status;
+    }
+
+    *results = multiResult;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+size_t croatiaPaymentMultiResultCount( MBCroatiaPaymentMultiResult const * results )
+{
+    return results != NULL ? results->count : 0;
+}
+
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentMultiResultAt( MBCroatiaPaymentMultiResult const * results, size_t index )
+{
+    if ( results == NULL || index >= results->count )
+    {
+        return NULL;
+    }
+    return croatiaDetachedPaymentResultGet( results->results[ index ] );
+}
+
+MBBarcodeLocation const * croatiaPaymentMultiResultLocationAt( MBCroatiaPaymentMultiResult const * results, size_t index )
+{
+    if ( results == NULL || index >= results->count )
+    {
+        return NULL;
+    }
+    return &results->locations[ index ];
+}
+
+MBRecognizerErrorStatus croatiaPaymentMultiResultDelete( MBCroatiaPaymentMultiResult ** results )
+{
+    size_t i;
+
+    if ( results == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *results != NULL )
+    {
+        if ( ( *results )->results != NULL )
+        {
+            for ( i = 0; i < ( *results )->count; ++i )
+            {
+                croatiaDetachedPaymentResultDelete( &( *results )->results[ i ] );
+            }
+        }
+        free( ( *results )->results );
+        free( ( *results )->locations );
+        free( *results );
+        *results = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file CroatiaPaymentMultiResult.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_MULTI_RESULT_H_
+#define CROATIA_PAYMENT_MULTI_RESULT_H_
+
+#include "BarcodeLocation.h"
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBCroatiaPaymentMultiResult
+ * @brief All payment results found on a single image, i.e. on a scanned sheet carrying multiple payment slips.
+ * Results are detached from the recognizers, so they stay valid while the recognizers process other images.
+ */
+struct MBCroatiaPaymentMultiResult;
+
+/**
+ * @brief Typedef for MBCroatiaPaymentMultiResult structure.
+ */
+typedef struct MBCroatiaPaymentMultiResult MBCroatiaPaymentMultiResult;
+
+/**
+ * @memberof MBCroatiaPaymentMultiResult
+ * @brief Finds all payment symbols on the given image.
+ *
+ * Recognizers report a single result per recognition, so the image is recognized repeatedly: after each pass the
+ * result is stored and the region of the found symbol is blanked out in a private copy of the image, until no more
+ * symbols are found. Reported location is the one of the last detection, which need not be the decoded symbol, so the
+ * region of the location is recognized again alone, and only results that decode in it are accepted, each with the
+ * location of its own symbol. A region is blanked only if a result was accepted from it. When no result decodes in
+ * the region, i.e. the last detection was an undecodable symbol, the search ends, so symbols found until then are
+ * returned. Original image is never modified. Recognizer runner is reset before each recognition, so recognizers in it
+ * must not be used for scanning a video stream at the same time.
+ *
+ * Example:
+ * @code
+ *  MBCroatiaPaymentMultiResult *results;
+ *
+ *  if ( croatiaPaymentMultiResultRecognize( &results, runner, pdf417Recognizer, qrRecognizer, image, 8 ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS ) {
+ *      for ( size_t i = 0; i < croatiaPaymentMultiResultCount( results ); ++i ) {
+ *          MBCroatiaBarcodePaymentRecognizerResult const * result = croatiaPaymentMultiResultAt( results, i );
+ *      }
+ *      croatiaPaymentMultiResultDelete( &results );
+ *  }
+ * @endcode
+ *
+ * @param results           Pointer to pointer referencing the created object, set to NULL if error occured.
+ * @param recognizerRunner  Recognizer runner containing the given recognizers.
+ * @param pdf417Recognizer  PDF417 payment recognizer in the runner, or NULL.
+ * @param qrRecognizer      QR payment recognizer in the runner, or NULL.
+ * @param image             Image that will be searched. Only raw image types with whole pixels are supported,
+ *                          i.e. not MB_RAW_IMAGE_TYPE_NV21.
+ * @param maxResults        Maximum number of results that will be returned.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentMultiResultRecognize
+(
+    MBCroatiaPaymentMultiResult            ** results,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    size_t                                    maxResults
+);
+
+/**
+ * @memberof MBCroatiaPaymentMultiResult
+ * @brief Returns the number of results found.
+ * @param results   Results of interest.
+ * @return number of results.
+ */
+size_t croatiaPaymentMultiResultCount( MBCroatiaPaymentMultiResult const * results );
+
+/**
+ * @memberof MBCroatiaPaymentMultiResult
+ * @brief Returns the result at the given index. Results are ordered as they were found.
+ * @param results   Results of interest.
+ * @param index     Index of the result, smaller than ::croatiaPaymentMultiResultCount.
+ * @return result at the given index, or NULL if index is out of range. Valid until results are destroyed.
+ */
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentMultiResultAt( MBCroatiaPaymentMultiResult const * results, size_t index );
+
+/**
+ * @memberof MBCroatiaPaymentMultiResult
+ * @brief Returns location of the symbol detected in the pass that produced the result at the given index.
+ * @param results   Results of interest.
+ * @param index     Index of the result, smaller than ::croatiaPaymentMultiResultCount.
+ * @return location of the result, or NULL if index is out of range.
+ */
+MBBarcodeLocation const * croatiaPaymentMultiResultLocationAt( MBCroatiaPaymentMultiResult const * results, size_t index );
+
+/**
+ * @memberof MBCroatiaPaymentMultiResult
+ * @brief Destroys the given MBCroatiaPaymentMultiResult and sets pointer to it to NULL.
+ * @param results   Pointer to pointer to MBCroatiaPaymentMultiResult that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentMultiResultDelete( MBCroatiaPaymentMultiResult ** results );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,414 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentNearDuplicateIndex.h"
+#include "BarcodeLocation.h"
+#include "CroatiaPaymentResultUtils.h"
+#include "Platform.h"
+#include "RecognizerImageHash.h"
+#include "RecognizerImageUtils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_CAPACITY             64
+#define DEFAULT_MAX_HAMMING_DISTANCE 0
+#define DEFAULT_MAX_AGE_MS           60000
+
+/* margin around the symbol of the stored region, relative to the symbol's larger dimension */
+#define REGION_MARGIN 0.1f
+
+/*
+ * Entries form a ring buffer ordered by insertion time: head is the oldest entry, so both eviction policies,
+ * capacity and age, always remove entries from the head.
+ */
+struct MBCroatiaPaymentNearDuplicateIndex
+{
+    MBCroatiaPaymentNearDuplicateIndexSettings settings;
+
+    size_t                            head;
+    size_t                            size;
+    uint64_t                        * hashes;
+    uint64_t                        * settingsKeys;
+    uint64_t                        * insertionTimes;
+    MBRectangle                     * regions;
+    MBCroatiaDetachedPaymentResult ** results;
+
+    size_t                            hits;
+    size_t                            misses;
+    size_t                            rejections;
+    size_t                            evictions;
+};
+
+void croatiaPaymentNearDuplicateIndexSettingsDefaultInit( MBCroatiaPaymentNearDuplicateIndexSettings * settings )
+{
+    settings->capacity           = DEFAULT_CAPACITY;
+    settings->maxHammingDistance = DEFAULT_MAX_HAMMING_DISTANCE;
+    settings->maxAgeMs           = DEFAULT_MAX_AGE_MS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexCreate( MBCroatiaPaymentNearDuplicateIndex ** index, MBCroatiaPaymentNearDuplicateIndexSettings const * settings )
+{
+    MBCroatiaPaymentNearDuplicateIndex * newIndex;
+    size_t                               capacity;
+
+    if ( index == NULL || ( settings != NULL && settings->capacity == 0 ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+    *index = NULL;
+
+    newIndex = ( MBCroatiaPaymentNearDuplicateIndex * ) calloc( 1, sizeof( MBCroatiaPaymentNearDuplicateIndex ) );
+    if ( newIndex == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    if ( settings != NULL )
+    {
+        newIndex->settings = *settings;
+    }
+    else
+    {
+        croatiaPaymentNearDuplicateIndexSettingsDefaultInit( &newIndex->settings );
+    }
+
+    capacity                 = newIndex->settings.capacity;
+    newIndex->hashes         = ( uint64_t * ) calloc( capacity, sizeof( uint64_t ) );
+    newIndex->settingsKeys   = ( uint64_t * ) calloc( capacity, sizeof( uint64_t ) );
+    newIndex->insertionTimes = ( uint64_t * ) calloc( capacity, sizeof( uint64_t ) );
+    newIndex->regions        = ( MBRectangle * ) calloc( capacity, sizeof( MBRectangle ) );
+    newIndex->results        = ( MBCroatiaDetachedPaymentResult ** ) calloc( capacity, sizeof( MBCroatiaDetachedPaymentResult * ) );
+
+    if ( newIndex->hashes == NULL || newIndex->settingsKeys == NULL || newIndex->insertionTimes == NULL || newIndex->regions == NULL ||
+         newIndex->results == NULL )
+    {
+        croatiaPaymentNearDuplicateIndexDelete( &newIndex );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    *index = newIndex;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static void evictOldest( MBCroatiaPaymentNearDuplicateIndex * index )
+{
+    croatiaDetachedPaymentResultDelete( &index->results[ index->head ] );
+    index->head = ( index->head + 1 ) % index->settings.capacity;
+    --index->size;
+    ++index->evictions;
+}
+
+static void evictExpired( MBCroatiaPaymentNearDuplicateIndex * index )
+{
+    uint64_t maxAgeNs;
+    uint64_t now;
+
+    if ( index->settings.maxAgeMs == 0 )
+    {
+        return;
+    }
+
+    maxAgeNs = ( uint64_t ) index->settings.maxAgeMs * 1000000u;
+    now      = platformMonotonicNanoseconds();
+
+    while ( index->size > 0 && now - index->insertionTimes[ index->head ] > maxAgeNs )
+    {
+        evictOldest( index );
+    }
+}
+
+/* returns the entry closest to the hash within the maximum distance, or capacity if there is none, and counts the lookup */
+static size_t findNearest( MBCroatiaPaymentNearDuplicateIndex * index, uint64_t perceptualHash, uint64_t settingsKey, int * distance )
+{
+    size_t best = 0;
+    int    bestDistance;
+    size_t i;
+
+    evictExpired( index );
+
+    bestDistance = index->settings.maxHammingDistance + 1;
+
+    for ( i = 0; i < index->size; ++i )
+    {
+        size_t entry = ( index->head + i ) % index->settings.capacity;
+        int    entryDistance;
+
+        if ( index->settingsKeys[ entry ] != settingsKey )
+        {
+            continue;
+        }
+
+        entryDistance = recognizerHashHammingDistance( index->hashes[ entry ], perceptualHash );
+        if ( entryDistance < bestDistance )
+        {
+            best         = entry;
+            bestDistance = entryDistance;
+        }
+    }
+
+    if ( bestDistance > index->settings.maxHammingDistance )
+    {
+        ++index->misses;
+        return index->settings.capacity;
+    }
+
+    ++index->hits;
+    if ( distance != NULL )
+    {
+        *distance = bestDistance;
+    }
+    return best;
+}
+
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentNearDuplicateIndexLookup( MBCroatiaPaymentNearDuplicateIndex * index, uint64_t perceptualHash, uint64_t settingsKey, int * distance )
+{
+    size_t entry;
+
+    if ( index == NULL )
+    {
+        return NULL;
+    }
+
+    entry = findNearest( index, perceptualHash, settingsKey, distance );
+    return entry < index->settings.capacity ? croatiaDetachedPaymentResultGet( index->results[ entry ] ) : NULL;
+}
+
+/* region may be NULL if the location of the symbol is not known, in which case the entry cannot be confirmed */
+static MBRecognizerErrorStatus insertEntry
+(
+    MBCroatiaPaymentNearDuplicateIndex            * index,
+    uint64_t                                        perceptualHash,
+    uint64_t                                        settingsKey,
+    MBRectangle                             const * region,
+    MBCroatiaBarcodePaymentRecognizerResult const * result
+)
+{
+    MBCroatiaDetachedPaymentResult * detached;
+    MBRecognizerErrorStatus          status;
+    size_t                           entry;
+
+    if ( result->baseResult.state != MB_RECOGNIZER_RESULT_STATE_VALID )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+    }
+
+    status = croatiaPaymentResultDetach( &detached, result );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    if ( index->size == index->settings.capacity )
+    {
+        evictOldest( index );
+    }
+
+    entry = ( index->head + index->size ) % index->settings.capacity;
+    index->hashes[ entry ]         = perceptualHash;
+    index->settingsKeys[ entry ]   = settingsKey;
+    index->insertionTimes[ entry ] = platformMonotonicNanoseconds();
+    index->results[ entry ]        = detached;
+    if ( region != NULL )
+    {
+        index->regions[ entry ] = *region;
+    }
+    else
+    {
+        memset( &index->regions[ entry ], 0, sizeof( MBRectangle ) );
+    }
+    ++index->size;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexInsert( MBCroatiaPaymentNearDuplicateIndex * index, uint64_t perceptualHash, uint64_t settingsKey, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    if ( index == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    return insertEntry( index, perceptualHash, settingsKey, NULL, result );
+}
+
+/* fetches result of the last recognition, preferring PDF417 */
+static void fetchResult
+(
+    MBCroatiaBarcodePaymentRecognizerResult * result,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer
+)
+{
+    memset( result, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+
+    if ( pdf417Recognizer != NULL )
+    {
+        croatiaPdf417PaymentRecognizerResult( result, pdf417Recognizer );
+    }
+    if ( qrRecognizer != NULL && result->baseResult.state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+    {
+        croatiaQrPaymentRecognizerResult( result, qrRecognizer );
+    }
+}
+
+/* recognizes only the region of the image in which the stored entry's symbol was found */
+static void recognizeRegion
+(
+    MBCroatiaBarcodePaymentRecognizerResult * result,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    MBRectangle                      const  * region
+)
+{
+    MBRecognizerImage * view;
+    int                 imageWidth  = recognizerImageGetWidth( image );
+    int                 imageHeight = recognizerImageGetHeight( image );
+    int                 left        = ( int ) ( region->x * imageWidth  + .5f );
+    int                 top         = ( int ) ( region->y * imageHeight + .5f );
+    int                 width       = ( int ) ( region->width  * imageWidth  + .5f );
+    int                 height      = ( int ) ( region->height * imageHeight + .5f );
+
+    memset( result, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+
+    if ( left + width > imageWidth )
+    {
+        width = imageWidth - left;
+    }
+    if ( top + height > imageHeight )
+    {
+        height = imageHeight - top;
+    }
+    if ( width <= 0 || height <= 0 ||
+         recognizerImageCreateView( &view, image, ( uint16_t ) left, ( uint16_t ) top, ( uint16_t ) width, ( uint16_t ) height ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return;
+    }
+
+    recognizerRunnerRecognizeFromImage( recognizerRunner, view, MB_FALSE, NULL );
+    recognizerImageDelete( &view );
+
+    fetchResult( result, pdf417Recognizer, qrRecognizer );
+}
+
+MBRecognizerResultState croatiaPaymentNearDuplicateIndexRecognize
+(
+    MBCroatiaPaymentNearDuplicateIndex      * index,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    uint64_t                                  settingsKey,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+)
+{
+    MBBarcodeLocation location;
+    MBRectangle       region;
+    uint64_t          perceptualHash;
+    size_t            entry;
+
+    if ( index == NULL || recognizerRunner == NULL || image == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_RESULT_STATE_EMPTY;
+    }
+
+    perceptualHash = recognizerImagePerceptualHash( image );
+    entry          = findNearest( index, perceptualHash, settingsKey, NULL );
+
+    /*
+     * slips of the same template hash alike, so a stored result is returned only if the barcode region of this image
+     * decodes to the same payment; decoding the region alone is still much cheaper than searching the whole page
+     */
+    if ( entry < index->settings.capacity && index->regions[ entry ].width > 0.f )
+    {
+        MBRectangle storedRegion = index->regions[ entry ];
+
+        recognizeRegion( result, recognizerRunner, pdf417Recognizer, qrRecognizer, image, &storedRegion );
+        if ( result->baseResult.state == MB_RECOGNIZER_RESULT_STATE_VALID )
+        {
+            MBCroatiaBarcodePaymentRecognizerResult const * stored = croatiaDetachedPaymentResultGet( index->results[ entry ] );
+
+            if ( croatiaPaymentResultEqual( result, stored ) )
+            {
+                *result = *stored;
+                return result->baseResult.state;
+            }
+
+            /* different slip of the same template at the same place, whose result is already known */
+            ++index->rejections;
+            insertEntry( index, perceptualHash, settingsKey, &storedRegion, result );
+            return result->baseResult.state;
+        }
+        ++index->rejections;
+    }
+
+    recognizerRunnerRecognizeFromImageWithLocation( recognizerRunner, image, MB_FALSE, NULL, &location );
+    fetchResult( result, pdf417Recognizer, qrRecognizer );
+
+    if ( barcodeLocationRegionOfInterest( &region, &location, recognizerImageGetWidth( image ), recognizerImageGetHeight( image ), REGION_MARGIN ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        insertEntry( index, perceptualHash, settingsKey, &region, result );
+    }
+    else
+    {
+        insertEntry( index, perceptualHash, settingsKey, NULL, result );
+    }
+
+    return result->baseResult.state;
+}
+
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexGetStats( MBCroatiaPaymentNearDuplicateIndexStats * stats, MBCroatiaPaymentNearDuplicateIndex const * index )
+{
+    if ( stats == NULL || index == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    stats->hits       = index->hits;
+    stats->misses     = index->misses;
+    stats->rejections = index->rejections;
+    stats->evictions  = index->evictions;
+    stats->size       = index->size;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexDelete( MBCroatiaPaymentNearDuplicateIndex ** index )
+{
+    size_t i;
+
+    if ( index == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *index != NULL )
+    {
+        if ( ( *index )->results != NULL )
+        {
+            for ( i = 0; i < ( *index )->settings.capacity; ++i )
+            {
+                croatiaDetachedPaymentResultDelete( &( *index )->results[ i ] );
+            }
+        }
+        free( ( *index )->hashes );
+        free( ( *index )->settingsKeys );
+        free( ( *index )->insertionTimes );
+        free( ( *index )->regions );
+        free( ( *index )->results );
+        free( *index );
+        *index = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
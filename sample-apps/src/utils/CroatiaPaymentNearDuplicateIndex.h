@@ -0,0 +1,202 @@
+/**
+ * @file CroatiaPaymentNearDuplicateIndex.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_NEAR_DUPLICATE_INDEX_H_
+#define CROATIA_PAYMENT_NEAR_DUPLICATE_INDEX_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBCroatiaPaymentNearDuplicateIndexSettings
+ * @brief Settings of MBCroatiaPaymentNearDuplicateIndex.
+ */
+struct MBCroatiaPaymentNearDuplicateIndexSettings
+{
+    /**
+     * Maximum number of results held by the index. When the index is full, the oldest result is evicted.
+     * By default, this is set to 64.
+     */
+    size_t capacity;
+
+    /**
+     * Maximum number of differing bits between perceptual hashes of two images that are considered visually identical.
+     * Perceptual hash describes only coarse appearance of the whole page, so slips printed from the same template
+     * differ in a few bits at most. Larger values find more re-encoded and cropped duplicates, but also more matches
+     * that ::croatiaPaymentNearDuplicateIndexRecognize has to reject after decoding the barcode region.
+     * By default, this is set to 0, i.e. only images with equal hashes are found.
+     */
+    int maxHammingDistance;
+
+    /**
+     * Maximum age of results, in milliseconds. Older results are evicted on lookup. 0 means that results never expire.
+     * By default, this is set to 60000, i.e. one minute.
+     */
+    uint32_t maxAgeMs;
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentNearDuplicateIndexSettings structure.
+ */
+typedef struct MBCroatiaPaymentNearDuplicateIndexSettings MBCroatiaPaymentNearDuplicateIndexSettings;
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndexSettings
+ * @brief Populate MBCroatiaPaymentNearDuplicateIndexSettings structure with default values.
+ * @param settings Settings that will be initialized.
+ */
+void croatiaPaymentNearDuplicateIndexSettingsDefaultInit( MBCroatiaPaymentNearDuplicateIndexSettings * settings );
+
+/**
+ * @struct MBCroatiaPaymentNearDuplicateIndex
+ * @brief Index of recently decoded payment results, keyed by perceptual hash of the image.
+ *
+ * Unlike MBCroatiaPaymentResultCache, which finds only byte-identical images, the index also finds re-encoded, rescaled
+ * or slightly cropped copies of a recently decoded image. Note that perceptual hash describes only coarse appearance of
+ * the image, so slips of the same template that differ only in printed data may have equal hashes. Therefore
+ * ::croatiaPaymentNearDuplicateIndexRecognize stores the region of the decoded symbol with every result and returns
+ * a stored result only after the same region of the new image decodes to the same payment. Only valid results are
+ * stored. Index must not be used from multiple threads at the same time.
+ */
+struct MBCroatiaPaymentNearDuplicateIndex;
+
+/**
+ * @brief Typedef for MBCroatiaPaymentNearDuplicateIndex structure.
+ */
+typedef struct MBCroatiaPaymentNearDuplicateIndex MBCroatiaPaymentNearDuplicateIndex;
+
+/**
+ * @struct MBCroatiaPaymentNearDuplicateIndexStats
+ * @brief Counters of MBCroatiaPaymentNearDuplicateIndex.
+ */
+struct MBCroatiaPaymentNearDuplicateIndexStats
+{
+    /** Number of lookups that found a near-duplicate. */
+    size_t hits;
+
+    /** Number of lookups that did not find a near-duplicate. */
+    size_t misses;
+
+    /**
+     * Number of near-duplicates found by ::croatiaPaymentNearDuplicateIndexRecognize that were not returned, because
+     * the barcode region of the new image did not decode to the same payment.
+     */
+    size_t rejections;
+
+    /** Number of results removed because the index was full or because they expired. */
+    size_t evictions;
+
+    /** Number of results currently stored. */
+    size_t size;
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentNearDuplicateIndexStats structure.
+ */
+typedef struct MBCroatiaPaymentNearDuplicateIndexStats MBCroatiaPaymentNearDuplicateIndexStats;
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Allocates and initializes new MBCroatiaPaymentNearDuplicateIndex object.
+ * @param index     Pointer to pointer referencing the created object.
+ * @param settings  Settings of the index, or NULL for default settings.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexCreate( MBCroatiaPaymentNearDuplicateIndex ** index, MBCroatiaPaymentNearDuplicateIndexSettings const * settings );
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Finds the most similar stored result within the maximum Hamming distance. The match is not confirmed, so it
+ * may belong to a different slip of the same template; use ::croatiaPaymentNearDuplicateIndexRecognize where the
+ * image is available.
+ * @param index             Index of interest.
+ * @param perceptualHash    Perceptual hash of the image, obtained with ::recognizerImagePerceptualHash.
+ * @param settingsKey       Key of the recognizers' settings, which must match exactly, i.e. from ::croatiaPaymentSettingsKey.
+ * @param distance          If not NULL, receives Hamming distance to the found result.
+ * @return stored result, valid until the next call which modifies the index, or NULL if there is no near-duplicate.
+ */
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentNearDuplicateIndexLookup( MBCroatiaPaymentNearDuplicateIndex * index, uint64_t perceptualHash, uint64_t settingsKey, int * distance );
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Stores copy of the valid result, evicting the oldest result if the index is full. Location of the symbol is
+ * not known, so ::croatiaPaymentNearDuplicateIndexRecognize cannot confirm the stored result and recognizes the whole
+ * image instead.
+ * @param index             Index of interest.
+ * @param perceptualHash    Perceptual hash of the image from which the result was obtained.
+ * @param settingsKey       Key of the recognizers' settings.
+ * @param result            Result that will be copied. Results which are not valid are ignored.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexInsert( MBCroatiaPaymentNearDuplicateIndex * index, uint64_t perceptualHash, uint64_t settingsKey, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Obtains result of the image from a near-duplicate, or by recognizing the image if there is none.
+ *
+ * Near-duplicate is confirmed by recognizing only the region in which its symbol was found: if the region decodes to
+ * the same payment, the stored result is returned; if it decodes to a different valid payment, that result is stored
+ * and returned. Otherwise the whole image is recognized, as if there was no near-duplicate.
+ * @param index             Index of interest.
+ * @param recognizerRunner  Recognizer runner containing the given recognizers.
+ * @param pdf417Recognizer  PDF417 payment recognizer in the runner, or NULL.
+ * @param qrRecognizer      QR payment recognizer in the runner, or NULL.
+ * @param image             Image that will be recognized.
+ * @param settingsKey       Key of the recognizers' settings.
+ * @param result            Receives the result. Pointers in the structure remain valid until the next call which
+ *                          modifies the index, or until the recognizer processes the next image.
+ * @return state of the result.
+ */
+MBRecognizerResultState croatiaPaymentNearDuplicateIndexRecognize
+(
+    MBCroatiaPaymentNearDuplicateIndex      * index,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    uint64_t                                  settingsKey,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+);
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Obtains counters of the index.
+ * @param stats Structure that will receive the counters.
+ * @param index Index of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexGetStats( MBCroatiaPaymentNearDuplicateIndexStats * stats, MBCroatiaPaymentNearDuplicateIndex const * index );
+
+/**
+ * @memberof MBCroatiaPaymentNearDuplicateIndex
+ * @brief Destroys the given MBCroatiaPaymentNearDuplicateIndex and sets pointer to it to NULL.
+ * @param index Pointer to pointer to MBCroatiaPaymentNearDuplicateIndex that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentNearDuplicateIndexDelete( MBCroatiaPaymentNearDuplicateIndex ** index );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
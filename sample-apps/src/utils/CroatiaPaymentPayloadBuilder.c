@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentPayloadBuilder.h"
+
+#include <string.h>
+
+#define HUB3_HEADER_VALUE       "HRVHUB30"
+#define HUB3_AMOUNT_DIGITS      15
+
+#define BANK_CODE_LENGTH        7
+#define ACCOUNT_NUMBER_LENGTH   10
+
+/* payload being written into a caller provided buffer */
+typedef struct PayloadWriter
+{
+    char * buffer;
+    size_t size;
+    size_t length;
+    int    overflow;
+} PayloadWriter;
+
+static void writeBytes( PayloadWriter * writer, char const * bytes, size_t count )
+{
+    if ( writer->overflow || writer->length + count >= writer->size )
+    {
+        writer->overflow = 1;
+        return;
+    }
+
+    memcpy( writer->buffer + writer->length, bytes, count );
+    writer->length += count;
+}
+
+/* field followed by the line feed that separates it from the next one */
+static int writeField( PayloadWriter * writer, char const * field, size_t maxLength )
+{
+    size_t length = field != NULL ? strlen( field ) : 0;
+
+    if ( length > maxLength || ( length > 0 && memchr( field, '\n', length ) != NULL ) )
+    {
+        return 0;
+    }
+
+    if ( length > 0 )
+    {
+        writeBytes( writer, field, length );
+    }
+    writeBytes( writer, "\n", 1 );
+
+    return 1;
+}
+
+static int isDigits( char const * text, size_t length )
+{
+    size_t i;
+
+    if ( text == NULL || strlen( text ) != length )
+    {
+        return 0;
+    }
+    for ( i = 0; i < length; ++i )
+    {
+        if ( text[ i ] < '0' || text[ i ] > '9' )
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+MBRecognizerErrorStatus croatiaPaymentPayloadBuild( char * payload, size_t payloadSize, MBCroatiaBarcodePaymentRecognizerResult const * result, size_t * payloadLength )
+{
+    PayloadWriter writer;
+    char          amount[ HUB3_AMOUNT_DIGITS + 1 ];
+    int           amountValue;
+    int           i;
+    int           valid;
+
+    if ( payload == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    amountValue = result->conversionToEurPerformed ? result->amountHrk : result->amountEur;
+    if ( amountValue < 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* amount in smallest monetary unit, left padded with zeros to fixed number of digits */
+    for ( i = HUB3_AMOUNT_DIGITS - 1; i >= 0; --i )
+    {
+        amount[ i ]  = ( char ) ( '0' + amountValue % 10 );
+        amountValue /= 10;
+    }
+    amount[ HUB3_AMOUNT_DIGITS ] = '\0';
+
+    writer.buffer   = payload;
+    writer.size     = payloadSize;
+    writer.length   = 0;
+    writer.overflow = 0;
+
+    valid = writeField( &writer, HUB3_HEADER_VALUE, 8 ) &&
+            writeField( &writer, result->conversionToEurPerformed ? "HRK" : "EUR", 3 ) &&
+            writeField( &writer, amount, HUB3_AMOUNT_DIGITS ) &&
+            writeField( &writer, result->payerName, 30 ) &&
+            writeField( &writer, result->payerAddress, 27 ) &&
+            writeField( &writer, result->payerDetailedAddress, 27 ) &&
+            writeField( &writer, result->recipientName, 25 ) &&
+            writeField( &writer, result->recipientAddress, 25 ) &&
+            writeField( &writer, result->recipientDetailedAddress, 27 ) &&
+            writeField( &writer, result->iban, 21 ) &&
+            writeField( &writer, result->referenceModel, 4 ) &&
+            writeField( &writer, result->reference, 22 ) &&
+            writeField( &writer, result->purposeCode, 4 ) &&
+            writeField( &writer, result->paymentDescription, 35 );
+    if ( !valid )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( result->optionalData != NULL && result->optionalData[ 0 ] != '\0' )
+    {
+        writeBytes( &writer, result->optionalData, strlen( result->optionalData ) );
+    }
+    else if ( !writer.overflow )
+    {
+        /* payment description is the last field, so it is not followed by a line feed */
+        --writer.length;
+    }
+
+    if ( writer.overflow )
+    {
+        if ( payloadSize > 0 )
+        {
+            payload[ 0 ] = '\0';
+        }
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    payload[ writer.length ] = '\0';
+    if ( payloadLength != NULL )
+    {
+        *payloadLength = writer.length;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaIbanFromBankAccount( char * iban, char const * bankCode, char const * accountNumber )
+{
+    /* "HR" is moved after the account number as letters 17 and 27 */
+    static char const countryDigits[] = "1727";
+
+    unsigned remainder = 0;
+    unsigned check;
+    int      i;
+
+    if ( iban == NULL || !isDigits( bankCode, BANK_CODE_LENGTH ) || !isDigits( accountNumber, ACCOUNT_NUMBER_LENGTH ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    for ( i = 0; i < BANK_CODE_LENGTH; ++i )
+    {
+        remainder = ( remainder * 10 + ( unsigned ) ( bankCode[ i ] - '0' ) ) % 97;
+    }
+    for ( i = 0; i < ACCOUNT_NUMBER_LENGTH; ++i )
+    {
+        remainder = ( remainder * 10 + ( unsigned ) ( accountNumber[ i ] - '0' ) ) % 97;
+    }
+    for ( i = 0; i < 4; ++i )
+    {
+        remainder = ( remainder * 10 + ( unsigned ) ( countryDigits[ i ] - '0' ) ) % 97;
+    }
+    /* check digits "00" */
+    remainder = remainder * 100 % 97;
+    check     = 98 - remainder;
+
+    iban[ 0 ] = 'H';
+    iban[ 1 ] = 'R';
+    iban[ 2 ] = ( char ) ( '0' + check / 10 );
+    iban[ 3 ] = ( char ) ( '0' + check % 10 );
+    memcpy( iban + 4, bankCode, BANK_CODE_LENGTH );
+    memcpy( iban + 4 + BANK_CODE_LENGTH, accountNumber, ACCOUNT_NUMBER_LENGTH );
+    iban[ 4 + BANK_CODE_LENGTH + ACCOUNT_NUMBER_LENGTH ] = '\0';
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file CroatiaPaymentPayloadBuilder.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_PAYLOAD_BUILDER_H_
+#define CROATIA_PAYMENT_PAYLOAD_BUILDER_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum length of HUB3 payload built by ::croatiaPaymentPayloadBuild without optional data, in bytes. */
+#define MB_CROATIA_PAYMENT_PAYLOAD_MAX_LENGTH 286
+
+/** @brief Size of buffer that receives IBAN from ::croatiaIbanFromBankAccount, including the terminating zero. */
+#define MB_CROATIA_IBAN_BUFFER_SIZE 22
+
+/**
+ * @brief Builds HUB3 ("HRVHUB30") payload from payment data, i.e. to print it as a barcode on an invoice.
+ *
+ * This is the inverse of ::croatiaPaymentPayloadParserParse: parsing the built payload gives back the same fields.
+ * Amount is encoded in EUR from amountEur, or in HRK from amountHrk if conversionToEurPerformed is set. Fields are
+ * copied as is, so they must already be in the character set expected by the reader of the barcode, and must fit into
+ * the field lengths of HUB3 standard (i.e. 30 bytes for payer name and 35 for payment description). NULL fields are
+ * encoded as empty. Optional data, if not empty, is appended after the payment description. Bank code and account
+ * number are not encoded, as they are part of IBAN (@see ::croatiaIbanFromBankAccount). Contents of the fields are not
+ * validated, so payloads with invalid IBAN or reference can be built on purpose (@see CroatiaPaymentValidation.h).
+ *
+ * @param payload       Buffer that receives zero-terminated payload.
+ * @param payloadSize   Size of the buffer, in bytes. MB_CROATIA_PAYMENT_PAYLOAD_MAX_LENGTH + 1 is enough for
+ *                      payloads without optional data.
+ * @param result        Payment data to encode.
+ * @param payloadLength If not NULL, receives length of the payload, without the terminating zero.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if any field is too long,
+ *         contains a line feed, or amount is negative, and MB_RECOGNIZER_ERROR_STATUS_FAIL if the buffer is too small.
+ */
+MBRecognizerErrorStatus croatiaPaymentPayloadBuild( char * payload, size_t payloadSize, MBCroatiaBarcodePaymentRecognizerResult const * result, size_t * payloadLength );
+
+/**
+ * @brief Composes Croatian IBAN from bank code and account number, computing its ISO 7064 mod 97-10 check digits.
+ * @param iban          Buffer of MB_CROATIA_IBAN_BUFFER_SIZE bytes that receives zero-terminated IBAN.
+ * @param bankCode      Seven digit bank code.
+ * @param accountNumber Ten digit account number.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if bank code or account
+ *         number do not have the correct number of digits.
+ */
+MBRecognizerErrorStatus croatiaIbanFromBankAccount( char * iban, char const * bankCode, char const * accountNumber );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentPayloadParser.h"
+#include "CroatiaPaymentValidation.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_CONVERSION_RATE 7.5345f
+
+/* HUB3 payload consists of 14 LF-separated fields, optionally followed by additional data */
+enum Hub3Field
+{
+    HUB3_HEADER,
+    HUB3_CURRENCY,
+    HUB3_AMOUNT,
+    HUB3_PAYER_NAME,
+    HUB3_PAYER_ADDRESS,
+    HUB3_PAYER_DETAILED_ADDRESS,
+    HUB3_RECIPIENT_NAME,
+    HUB3_RECIPIENT_ADDRESS,
+    HUB3_RECIPIENT_DETAILED_ADDRESS,
+    HUB3_IBAN,
+    HUB3_REFERENCE_MODEL,
+    HUB3_REFERENCE,
+    HUB3_PURPOSE_CODE,
+    HUB3_DESCRIPTION,
+    HUB3_NUM_FIELDS
+};
+
+#define HUB3_HEADER_VALUE       "HRVHUB30"
+#define HUB3_MAX_AMOUNT_DIGITS  15
+
+/* length of Croatian IBAN and positions of bank code and account number within it */
+#define CROATIAN_IBAN_LENGTH    21
+#define BANK_CODE_OFFSET        4
+#define BANK_CODE_LENGTH        7
+#define ACCOUNT_NUMBER_OFFSET   11
+#define ACCOUNT_NUMBER_LENGTH   10
+
+struct MBCroatiaPaymentPayloadParser
+{
+    float                                   conversionRate;
+    MBCroatiaBarcodePaymentRecognizerResult result;
+
+    /* copy of the payload, split into zero-terminated fields which are referenced by result */
+    char                                  * buffer;
+    size_t                                  bufferCapacity;
+
+    char                                    bankCode[ BANK_CODE_LENGTH + 1 ];
+    char                                    accountNumber[ ACCOUNT_NUMBER_LENGTH + 1 ];
+};
+
+MBRecognizerErrorStatus croatiaPaymentPayloadParserCreate( MBCroatiaPaymentPayloadParser ** parser, MBCroatiaCommonBarcodePaymentRecognizerSettings const * settings )
+{
+    if ( parser == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *parser = NULL;
+
+    if ( settings != NULL && !( settings->conversionRate > 0.f ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_SETTINGS;
+    }
+
+    *parser = ( MBCroatiaPaymentPayloadParser * ) calloc( 1, sizeof( MBCroatiaPaymentPayloadParser ) );
+    if ( *parser == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    ( *parser )->conversionRate = settings != NULL ? settings->conversionRate : DEFAULT_CONVERSION_RATE;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentPayloadParserDelete( MBCroatiaPaymentPayloadParser ** parser )
+{
+    if ( parser == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *parser != NULL )
+    {
+        free( ( *parser )->buffer );
+        free( *parser );
+        *parser = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static int reserveBuffer( MBCroatiaPaymentPayloadParser * parser, size_t capacity )
+{
+    char * newBuffer;
+
+    if ( capacity <= parser->bufferCapacity )
+    {
+        return 1;
+    }
+
+    /* grow geometrically so that batches of slightly different payloads do not reallocate every time */
+    if ( capacity < 2 * parser->bufferCapacity )
+    {
+        capacity = 2 * parser->bufferCapacity;
+    }
+
+    newBuffer = ( char * ) realloc( parser->buffer, capacity );
+    if ( newBuffer == NULL )
+    {
+        return 0;
+    }
+
+    parser->buffer         = newBuffer;
+    parser->bufferCapacity = capacity;
+
+    return 1;
+}
+
+static void clearResult( MBCroatiaBarcodePaymentRecognizerResult * result )
+{
+    static char const empty[] = "";
+
+    memset( result, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+
+    result->baseResult.state         = MB_RECOGNIZER_RESULT_STATE_EMPTY;
+    result->payerName                = empty;
+    result->payerAddress             = empty;
+    result->payerDetailedAddress     = empty;
+    result->recipientName            = empty;
+    result->recipientAddress         = empty;
+    result->recipientDetailedAddress = empty;
+    result->accountNumber            = empty;
+    result->bankCode                 = empty;
+    result->iban                     = empty;
+    result->referenceModel           = empty;
+    result->reference                = empty;
+    result->purposeCode              = empty;
+    result->paymentDescription       = empty;
+    result->paymentDescriptionCode   = empty;
+    result->optionalData             = empty;
+    result->dueDate.originalString   = empty;
+    result->dueDate.empty            = 1;
+}
+
+/* splits buffer into at most HUB3_NUM_FIELDS zero-terminated fields, the remainder is left intact as additional data */
+static size_t splitFields( char * buffer, size_t length, char ** fields, char ** additionalData )
+{
+    size_t numFields = 0;
+    char * fieldStart = buffer;
+    char * end = buffer + length;
+    char * current;
+
+    *additionalData = NULL;
+
+    for ( current = buffer; current < end && numFields < HUB3_NUM_FIELDS; ++current )
+    {
+        if ( *current == '\n' )
+        {
+            *current = '\0';
+            if ( current > fieldStart && current[ -1 ] == '\r' )
+            {
+                current[ -1 ] = '\0';
+            }
+            fields[ numFields++ ] = fieldStart;
+            fieldStart = current + 1;
+        }
+    }
+
+    if ( numFields < HUB3_NUM_FIELDS )
+    {
+        /* last field is not terminated by a newline */
+        if ( fieldStart < end || numFields == HUB3_NUM_FIELDS - 1 )
+        {
+            if ( end > fieldStart && end[ -1 ] == '\r' )
+            {
+                end[ -1 ] = '\0';
+            }
+            fields[ numFields++ ] = fieldStart;
+        }
+    }
+    else if ( fieldStart < end )
+    {
+        *additionalData = fieldStart;
+    }
+
+    return numFields;
+}
+
+/* parses amount given as fixed number of digits, in smallest monetary unit */
+static int parseAmount( char const * text, int * amount )
+{
+    long long value  = 0;
+    size_t    digits = 0;
+
+    for ( ; *text != '\0'; ++text, ++digits )
+    {
+        if ( *text < '0' || *text > '9' || digits == HUB3_MAX_AMOUNT_DIGITS )
+        {
+            return 0;
+        }
+        value = value * 10 + ( *text - '0' );
+    }
+
+    if ( digits == 0 || value > INT_MAX )
+    {
+        return 0;
+    }
+
+    *amount = ( int ) value;
+    return 1;
+}
+
+static void extractBankAccount( MBCroatiaPaymentPayloadParser * parser )
+{
+    char const * iban = parser->result.iban;
+
+    if ( strlen( iban ) != CROATIAN_IBAN_LENGTH || iban[ 0 ] != 'H' || iban[ 1 ] != 'R' )
+    {
+        return;
+    }
+
+    memcpy( parser->bankCode, iban + BANK_CODE_OFFSET, BANK_CODE_LENGTH );
+    parser->bankCode[ BANK_CODE_LENGTH ] = '\0';
+    memcpy( parser->accountNumber, iban + ACCOUNT_NUMBER_OFFSET, ACCOUNT_NUMBER_LENGTH );
+    parser->accountNumber[ ACCOUNT_NUMBER_LENGTH ] = '\0';
+
+    parser->result.bankCode      = parser->bankCode;
+    parser->result.accountNumber = parser->accountNumber;
+}
+
+MBRecognizerResultState croatiaPaymentPayloadParserParse( MBCroatiaPaymentPayloadParser * parser, char const * payload, size_t payloadLength )
+{
+    MBCroatiaBarcodePaymentRecognizerResult * result = &parser->result;
+    char                                    * fields[ HUB3_NUM_FIELDS ];
+    char                                    * additionalData;
+    size_t                                    numFields;
+    int                                       amount   = 0;
+    MBBool                                    complete = MB_TRUE;
+
+    clearResult( result );
+
+    if ( payload == NULL || !reserveBuffer( parser, payloadLength + 1 ) )
+    {
+        return result->baseResult.state;
+    }
+
+    memcpy( parser->buffer, payload, payloadLength );
+    parser->buffer[ payloadLength ] = '\0';
+
+    numFields = splitFields( parser->buffer, payloadLength, fields, &additionalData );
+    if ( numFields == 0 || strcmp( fields[ HUB3_HEADER ], HUB3_HEADER_VALUE ) != 0 )
+    {
+        return result->baseResult.state;
+    }
+
+    result->slipId = MB_CROATIA_PAYMENT_BARCODE_TYPE_HUB3;
+
+    /* fields that are missing from truncated payload remain empty */
+    if ( numFields > HUB3_PAYER_NAME                 ) result->payerName                = fields[ HUB3_PAYER_NAME ];
+    if ( numFields > HUB3_PAYER_ADDRESS              ) result->payerAddress             = fields[ HUB3_PAYER_ADDRESS ];
+    if ( numFields > HUB3_PAYER_DETAILED_ADDRESS     ) result->payerDetailedAddress     = fields[ HUB3_PAYER_DETAILED_ADDRESS ];
+    if ( numFields > HUB3_RECIPIENT_NAME             ) result->recipientName            = fields[ HUB3_RECIPIENT_NAME ];
+    if ( numFields > HUB3_RECIPIENT_ADDRESS          ) result->recipientAddress         = fields[ HUB3_RECIPIENT_ADDRESS ];
+    if ( numFields > HUB3_RECIPIENT_DETAILED_ADDRESS ) result->recipientDetailedAddress = fields[ HUB3_RECIPIENT_DETAILED_ADDRESS ];
+    if ( numFields > HUB3_IBAN                       ) result->iban                     = fields[ HUB3_IBAN ];
+    if ( numFields > HUB3_REFERENCE_MODEL            ) result->referenceModel           = fields[ HUB3_REFERENCE_MODEL ];
+    if ( numFields > HUB3_REFERENCE                  ) result->reference                = fields[ HUB3_REFERENCE ];
+    if ( numFields > HUB3_PURPOSE_CODE               ) result->purposeCode              = fields[ HUB3_PURPOSE_CODE ];
+    if ( numFields > HUB3_DESCRIPTION                ) result->paymentDescription       = fields[ HUB3_DESCRIPTION ];
+    if ( additionalData != NULL                      ) result->optionalData             = additionalData;
+
+    extractBankAccount( parser );
+
+    if ( numFields < HUB3_NUM_FIELDS || !ibanIsValid( result->iban ) )
+    {
+        complete = MB_FALSE;
+    }
+
+    /* reference model is optional in some payloads, but when present reference must conform to it */
+    if ( result->referenceModel[ 0 ] != '\0' && !croatiaReferenceIsValid( result->referenceModel, result->reference ) )
+    {
+        complete = MB_FALSE;
+    }
+
+    if ( numFields > HUB3_AMOUNT && parseAmount( fields[ HUB3_AMOUNT ], &amount ) )
+    {
+        if ( strcmp( fields[ HUB3_CURRENCY ], "EUR" ) == 0 )
+        {
+            result->amountEur = amount;
+        }
+        else if ( strcmp( fields[ HUB3_CURRENCY ], "HRK" ) == 0 )
+        {
+            result->amountHrk                = amount;
+            result->amountEur                = ( int ) ( amount / ( double ) parser->conversionRate + 0.5 );
+            result->conversionToEurPerformed = MB_TRUE;
+        }
+        else
+        {
+            complete = MB_FALSE;
+        }
+    }
+    else
+    {
+        complete = MB_FALSE;
+    }
+
+    result->uncertain        = complete ? MB_FALSE : MB_TRUE;
+    result->baseResult.state = complete ? MB_RECOGNIZER_RESULT_STATE_VALID : MB_RECOGNIZER_RESULT_STATE_UNCERTAIN;
+
+    return result->baseResult.state;
+}
+
+MBRecognizerErrorStatus croatiaPaymentPayloadParserResult( MBCroatiaBarcodePaymentRecognizerResult * result, MBCroatiaPaymentPayloadParser const * parser )
+{
+    if ( result == NULL || parser == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *result = parser->result;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+size_t croatiaPaymentPayloadParserParseBatch
+(
+    MBCroatiaPaymentPayloadParser        * parser,
+    char                         const * const * payloads,
+    size_t                         const * payloadLengths,
+    size_t                                 count,
+    MBCroatiaPaymentPayloadResultHandler   handler,
+    void                                 * userData
+)
+{
+    size_t numValid = 0;
+    size_t i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        if ( croatiaPaymentPayloadParserParse( parser, payloads[ i ], payloadLengths[ i ] ) == MB_RECOGNIZER_RESULT_STATE_VALID )
+        {
+            ++numValid;
+        }
+
+        if ( handler != NULL )
+        {
+            handler( userData, i, &parser->result );
+        }
+    }
+
+    return numValid;
+}
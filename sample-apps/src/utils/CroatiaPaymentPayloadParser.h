@@ -0,0 +1,119 @@
+/**
+ * @file CroatiaPaymentPayloadParser.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_PAYLOAD_PARSER_H_
+#define CROATIA_PAYMENT_PAYLOAD_PARSER_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBCroatiaPaymentPayloadParser
+ * @brief Parser of already decoded HUB3 payment barcode payloads (i.e. text of the PDF417 or QR code
+ * obtained from e-invoice or hardware barcode scanner).
+ *
+ * Parser produces MBCroatiaBarcodePaymentRecognizerResult, same as MBCroatiaPdf417PaymentRecognizer and
+ * MBCroatiaQrPaymentRecognizer, without running any image processing. Only HUB3 ("HRVHUB30") payloads are supported.
+ * Strings are returned exactly as encoded in the payload, i.e. no character set conversion is performed.
+ *
+ * Single parser must not be used from multiple threads at the same time, but any number of parsers may be used in parallel.
+ */
+struct MBCroatiaPaymentPayloadParser;
+
+/**
+ * @brief Typedef for the MBCroatiaPaymentPayloadParser structure.
+ */
+typedef struct MBCroatiaPaymentPayloadParser MBCroatiaPaymentPayloadParser;
+
+/**
+ * @memberof MBCroatiaPaymentPayloadParser
+ * @brief Allocates and initializes new MBCroatiaPaymentPayloadParser object.
+ * @param parser    Pointer to pointer referencing the created MBCroatiaPaymentPayloadParser object.
+ * @param settings  Settings that will be used for parsing, or NULL to use default conversion rate.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentPayloadParserCreate( MBCroatiaPaymentPayloadParser ** parser, MBCroatiaCommonBarcodePaymentRecognizerSettings const * settings );
+
+/**
+ * @memberof MBCroatiaPaymentPayloadParser
+ * @brief Parses the given payload.
+ * @param parser        Parser that will hold the result.
+ * @param payload       Payload of the payment barcode. Need not be zero-terminated. Lines may be separated with LF or CR LF.
+ * @param payloadLength Length of the payload, in bytes.
+ * @return state of the parsed result. MB_RECOGNIZER_RESULT_STATE_EMPTY is returned if payload is not a HUB3 payload,
+ *         MB_RECOGNIZER_RESULT_STATE_UNCERTAIN if some mandatory fields are missing or malformed, or if IBAN or
+ *         reference fail validation (see CroatiaPaymentValidation.h).
+ */
+MBRecognizerResultState croatiaPaymentPayloadParserParse( MBCroatiaPaymentPayloadParser * parser, char const * payload, size_t payloadLength );
+
+/**
+ * @memberof MBCroatiaPaymentPayloadParser
+ * @brief Obtains the result of the last parsing.
+ * @param result    Structure that will be filled with the parsed data.
+ * Note that all pointers in structure will remain valid until given parser is destroyed or is used for parsing the next payload.
+ * @param parser    Parser from which result should be obtained.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentPayloadParserResult( MBCroatiaBarcodePaymentRecognizerResult * result, MBCroatiaPaymentPayloadParser const * parser );
+
+/**
+ * @brief Function that receives results of ::croatiaPaymentPayloadParserParseBatch.
+ * @param userData  User data given to ::croatiaPaymentPayloadParserParseBatch.
+ * @param index     Index of the payload whose result is given.
+ * @param result    Parsed result. Pointers in the structure are valid only during the call.
+ */
+typedef void ( *MBCroatiaPaymentPayloadResultHandler )( void * userData, size_t index, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @memberof MBCroatiaPaymentPayloadParser
+ * @brief Parses multiple payloads, reusing the parser's memory for every payload.
+ * @param parser            Parser that will be used for parsing.
+ * @param payloads          Array of payloads.
+ * @param payloadLengths    Array of payload lengths.
+ * @param count             Number of payloads.
+ * @param handler           Function that will receive result of each payload, in order.
+ * @param userData          Pointer that will be given to handler.
+ * @return number of payloads that were parsed as MB_RECOGNIZER_RESULT_STATE_VALID.
+ */
+size_t croatiaPaymentPayloadParserParseBatch
+(
+    MBCroatiaPaymentPayloadParser        * parser,
+    char                         const * const * payloads,
+    size_t                         const * payloadLengths,
+    size_t                                 count,
+    MBCroatiaPaymentPayloadResultHandler   handler,
+    void                                 * userData
+);
+
+/**
+ * @memberof MBCroatiaPaymentPayloadParser
+ * @brief Destroys the given MBCroatiaPaymentPayloadParser.
+ * @param parser    Pointer to pointer to MBCroatiaPaymentPayloadParser that needs to be destroyed.
+ * After destruction, the pointer will be set to NULL.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentPayloadParserDelete( MBCroatiaPaymentPayloadParser ** parser );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
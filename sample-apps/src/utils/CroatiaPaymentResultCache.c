@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentResultCache.h"
+#include "CroatiaPaymentResultUtils.h"
+#include "RecognizerImageHash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Entries are kept in plain arrays and found by linear search over the keys. For capacities of up to a few
+ * thousand entries this costs microseconds, which is negligible compared to recognition of a single image.
+ */
+struct MBCroatiaPaymentResultCache
+{
+    size_t                            capacity;
+    size_t                            size;
+    uint64_t                          useCounter;
+    uint64_t                        * keys;
+    uint64_t                        * lastUses;
+    MBCroatiaDetachedPaymentResult ** results;
+
+    size_t                            hits;
+    size_t                            misses;
+    size_t                            evictions;
+};
+
+MBRecognizerErrorStatus croatiaPaymentResultCacheCreate( MBCroatiaPaymentResultCache ** cache, size_t capacity )
+{
+    MBCroatiaPaymentResultCache * newCache;
+
+    if ( cache == NULL || capacity == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+    *cache = NULL;
+
+    newCache = ( MBCroatiaPaymentResultCache * ) calloc( 1, sizeof( MBCroatiaPaymentResultCache ) );
+    if ( newCache == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    newCache->capacity = capacity;
+    newCache->keys     = ( uint64_t * ) calloc( capacity, sizeof( uint64_t ) );
+    newCache->lastUses = ( uint64_t * ) calloc( capacity, sizeof( uint64_t ) );
+    newCache->results  = ( MBCroatiaDetachedPaymentResult ** ) calloc( capacity, sizeof( MBCroatiaDetachedPaymentResult * ) );
+
+    if ( newCache->keys == NULL || newCache->lastUses == NULL || newCache->results == NULL )
+    {
+        croatiaPaymentResultCacheDelete( &newCache );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    *cache = newCache;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+uint64_t croatiaPaymentSettingsKey( MBCroatiaPdf417PaymentRecognizerSettings const * pdf417Settings, MBCroatiaQrPaymentRecognizerSettings const * qrSettings )
+{
+    uint64_t key = 0;
+    uint32_t rate;
+
+    /* settings are hashed member by member, because padding bytes of the structures are unspecified */
+    if ( pdf417Settings != NULL )
+    {
+        memcpy( &rate, &pdf417Settings->common.conversionRate, sizeof( rate ) );
+        key = recognizerHashCombine( key, ( ( uint64_t ) 1 << 40 ) | ( ( uint64_t ) ( pdf417Settings->uncertainDecoding != 0 ) << 32 ) | rate );
+    }
+    if ( qrSettings != NULL )
+    {
+        memcpy( &rate, &qrSettings->common.conversionRate, sizeof( rate ) );
+        key = recognizerHashCombine( key, ( ( uint64_t ) 2 << 40 ) | ( ( uint64_t ) ( qrSettings->slowerThoroughScan != 0 ) << 32 ) | rate );
+    }
+
+    return key;
+}
+
+static size_t findEntry( MBCroatiaPaymentResultCache const * cache, uint64_t key )
+{
+    size_t i;
+
+    for ( i = 0; i < cache->size; ++i )
+    {
+        if ( cache->keys[ i ] == key )
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentResultCacheLookup( MBCroatiaPaymentResultCache * cache, uint64_t key )
+{
+    size_t entry;
+
+    if ( cache == NULL )
+    {
+        return NULL;
+    }
+
+    entry = findEntry( cache, key );
+    if ( entry == cache->size )
+    {
+        ++cache->misses;
+        return NULL;
+    }
+
+    ++cache->hits;
+    cache->lastUses[ entry ] = ++cache->useCounter;
+    return croatiaDetachedPaymentResultGet( cache->results[ entry ] );
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultCacheInsert( MBCroatiaPaymentResultCache * cache, uint64_t key, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    MBCroatiaDetachedPaymentResult * detached;
+    MBRecognizerErrorStatus          status;
+    size_t                           entry;
+    size_t                           i;
+
+    if ( cache == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    status = croatiaPaymentResultDetach( &detached, result );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    entry = findEntry( cache, key );
+    if ( entry == cache->size )
+    {
+        if ( cache->size < cache->capacity )
+        {
+            ++cache->size;
+        }
+        else
+        {
+            /* evict least recently used entry */
+            entry = 0;
+            for ( i = 1; i < cache->size; ++i )
+            {
+                if ( cache->lastUses[ i ] < cache->lastUses[ entry ] )
+                {
+                    entry = i;
+                }
+            }
+            ++cache->evictions;
+        }
+    }
+
+    croatiaDetachedPaymentResultDelete( &cache->results[ entry ] );
+    cache->keys[ entry ]     = key;
+    cache->lastUses[ entry ] = ++cache->useCounter;
+    cache->results[ entry ]  = detached;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerResultState croatiaPaymentResultCacheRecognize
+(
+    MBCroatiaPaymentResultCache            * cache,
+    MBRecognizerRunner                     * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const * qrRecognizer,
+    MBRecognizerImage                const * image,
+    uint64_t                                 settingsKey,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+)
+{
+    MBCroatiaBarcodePaymentRecognizerResult const * cached;
+    uint64_t                                        key;
+
+    if ( cache == NULL || recognizerRunner == NULL || image == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_RESULT_STATE_EMPTY;
+    }
+
+    key    = recognizerHashCombine( recognizerImageContentHash( image ), settingsKey );
+    cached = croatiaPaymentResultCacheLookup( cache, key );
+
+    if ( cached == NULL )
+    {
+        memset( result, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+
+        recognizerRunnerRecognizeFromImage( recognizerRunner, image, MB_FALSE, NULL );
+
+        if ( pdf417Recognizer != NULL )
+        {
+            croatiaPdf417PaymentRecognizerResult( result, pdf417Recognizer );
+        }
+        if ( qrRecognizer != NULL && result->baseResult.state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+        {
+            croatiaQrPaymentRecognizerResult( result, qrRecognizer );
+        }
+
+        /* if result cannot be stored, the recognizer's result is returned directly */
+        if ( croatiaPaymentResultCacheInsert( cache, key, result ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            return result->baseResult.state;
+        }
+
+        cached = croatiaDetachedPaymentResultGet( cache->results[ findEntry( cache, key ) ] );
+    }
+
+    *result = *cached;
+    return result->baseResult.state;
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultCacheGetStats( MBCroatiaPaymentResultCacheStats * stats, MBCroatiaPaymentResultCache const * cache )
+{
+    if ( stats == NULL || cache == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    stats->hits      = cache->hits;
+    stats->misses    = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->size      = cache->size;
+    stats->capacity  = cache->capacity;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultCacheDelete( MBCroatiaPaymentResultCache ** cache )
+{
+    size_t i;
+
+    if ( cache == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *cache != NULL )
+    {
+        if ( ( *cache )->results != NULL )
+        {
+            for ( i = 0; i < ( *cache )->size; ++i )
+            {
+                croatiaDetachedPaymentResultDelete( &( *cache )->results[ i ] );
+            }
+        }
+        free( ( *cache )->keys );
+        free( ( *cache )->lastUses );
+        free( ( *cache )->results );
+        free( *cache );
+        *cache = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
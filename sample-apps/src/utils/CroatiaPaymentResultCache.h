@@ -0,0 +1,157 @@
+/**
+ * @file CroatiaPaymentResultCache.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_RESULT_CACHE_H_
+#define CROATIA_PAYMENT_RESULT_CACHE_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBCroatiaPaymentResultCache
+ * @brief Bounded least-recently-used cache of payment results, keyed by image contents and recognizer settings.
+ *
+ * Re-uploaded or forwarded images are recognized only once; all subsequent recognitions of the same pixels with the
+ * same settings return the stored result without running the recognizers. Results of images without any payment
+ * symbol are cached as well. Cache must not be used from multiple threads at the same time.
+ */
+struct MBCroatiaPaymentResultCache;
+
+/**
+ * @brief Typedef for MBCroatiaPaymentResultCache structure.
+ */
+typedef struct MBCroatiaPaymentResultCache MBCroatiaPaymentResultCache;
+
+/**
+ * @struct MBCroatiaPaymentResultCacheStats
+ * @brief Counters of MBCroatiaPaymentResultCache, used for sizing the cache.
+ */
+struct MBCroatiaPaymentResultCacheStats
+{
+    /** Number of lookups that found the stored result. */
+    size_t hits;
+
+    /** Number of lookups that did not find the stored result. */
+    size_t misses;
+
+    /** Number of results removed from the cache to make room for newer ones. */
+    size_t evictions;
+
+    /** Number of results currently stored. */
+    size_t size;
+
+    /** Maximum number of stored results. */
+    size_t capacity;
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentResultCacheStats structure.
+ */
+typedef struct MBCroatiaPaymentResultCacheStats MBCroatiaPaymentResultCacheStats;
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Allocates and initializes new MBCroatiaPaymentResultCache object.
+ * @param cache     Pointer to pointer referencing the created object.
+ * @param capacity  Maximum number of results held by the cache. Must be larger than 0.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultCacheCreate( MBCroatiaPaymentResultCache ** cache, size_t capacity );
+
+/**
+ * @brief Computes key of the recognizer settings that affect the result, to be combined with image contents.
+ * @param pdf417Settings    Settings of PDF417 payment recognizer in the runner, or NULL.
+ * @param qrSettings        Settings of QR payment recognizer in the runner, or NULL.
+ * @return settings key.
+ */
+uint64_t croatiaPaymentSettingsKey( MBCroatiaPdf417PaymentRecognizerSettings const * pdf417Settings, MBCroatiaQrPaymentRecognizerSettings const * qrSettings );
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Obtains payment result of the given image, either from the cache or by recognizing the image.
+ *
+ * On a miss, image is recognized as a still image, result of PDF417 recognizer (or of QR recognizer, if PDF417 result
+ * is empty) is stored in the cache and returned.
+ *
+ * @param cache             Cache of interest.
+ * @param recognizerRunner  Recognizer runner containing the given recognizers.
+ * @param pdf417Recognizer  PDF417 payment recognizer in the runner, or NULL.
+ * @param qrRecognizer      QR payment recognizer in the runner, or NULL.
+ * @param image             Image that will be recognized.
+ * @param settingsKey       Key of the recognizers' settings, obtained with ::croatiaPaymentSettingsKey.
+ * @param result            Receives the result. Pointers in the structure remain valid until the next call which
+ *                          modifies the cache, or until the cache is destroyed.
+ * @return state of the result.
+ */
+MBRecognizerResultState croatiaPaymentResultCacheRecognize
+(
+    MBCroatiaPaymentResultCache            * cache,
+    MBRecognizerRunner                     * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const * qrRecognizer,
+    MBRecognizerImage                const * image,
+    uint64_t                                 settingsKey,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+);
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Finds the stored result for the given key, i.e. for results produced outside of ::croatiaPaymentResultCacheRecognize.
+ * @param cache Cache of interest.
+ * @param key   Key of the result, i.e. recognizerHashCombine( recognizerImageContentHash( image ), settingsKey ).
+ * @return stored result, valid until the next call which modifies the cache, or NULL if there is no such result.
+ */
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentResultCacheLookup( MBCroatiaPaymentResultCache * cache, uint64_t key );
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Stores copy of the result under the given key, evicting the least recently used result if the cache is full.
+ * @param cache     Cache of interest.
+ * @param key       Key of the result.
+ * @param result    Result that will be copied into the cache.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultCacheInsert( MBCroatiaPaymentResultCache * cache, uint64_t key, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Obtains counters of the cache.
+ * @param stats Structure that will receive the counters.
+ * @param cache Cache of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultCacheGetStats( MBCroatiaPaymentResultCacheStats * stats, MBCroatiaPaymentResultCache const * cache );
+
+/**
+ * @memberof MBCroatiaPaymentResultCache
+ * @brief Destroys the given MBCroatiaPaymentResultCache and sets pointer to it to NULL.
+ * @param cache Pointer to pointer to MBCroatiaPaymentResultCache that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultCacheDelete( MBCroatiaPaymentResultCache ** cache );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentResultUtils.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct MBCroatiaDetachedPaymentResult
+{
+    MBCroatiaBarcodePaymentRecognizerResult result;
+    /* strings of the result follow the structure in the same allocation */
+};
+
+typedef struct StringField
+{
+    char const * name;
+    size_t       offset;
+} StringField;
+
+#define STRING_FIELD( field ) { #field, offsetof( MBCroatiaBarcodePaymentRecognizerResult, field ) }
+
+/* order of the fields defines the binary format, so new fields may only be appended */
+static StringField const stringFields[] =
+{
+    STRING_FIELD( payerName ),
+    STRING_FIELD( payerAddress ),
+    STRING_FIELD( payerDetailedAddress ),
+    STRING_FIELD( recipientName ),
+    STRING_FIELD( recipientAddress ),
+    STRING_FIELD( recipientDetailedAddress ),
+    STRING_FIELD( accountNumber ),
+    STRING_FIELD( bankCode ),
+    STRING_FIELD( iban ),
+    STRING_FIELD( referenceModel ),
+    STRING_FIELD( reference ),
+    STRING_FIELD( purposeCode ),
+    STRING_FIELD( paymentDescription ),
+    STRING_FIELD( paymentDescriptionCode ),
+    STRING_FIELD( optionalData )
+};
+
+#define NUM_STRING_FIELDS ( sizeof( stringFields ) / sizeof( stringFields[ 0 ] ) )
+
+static char const ** mutableStringField( MBCroatiaBarcodePaymentRecognizerResult * result, size_t field )
+{
+    return ( char const ** ) ( ( char * ) result + stringFields[ field ].offset );
+}
+
+static char const * rawStringFieldValue( MBCroatiaBarcodePaymentRecognizerResult const * result, size_t field )
+{
+    return *( char const * const * ) ( ( char const * ) result + stringFields[ field ].offset );
+}
+
+static char const * stringFieldValue( MBCroatiaBarcodePaymentRecognizerResult const * result, size_t field )
+{
+    char const * value = rawStringFieldValue( result, field );
+    return value != NULL ? value : "";
+}
+
+/*
+ * Writer keeps counting the length even after the buffer is exhausted, so that a single pass
+ * both serializes the record and determines the required capacity.
+ */
+typedef struct Writer
+{
+    char   * buffer;
+    size_t   capacity;
+    size_t   position;
+} Writer;
+
+static void writeBytes( Writer * writer, void const * bytes, size_t count )
+{
+    if ( count > 0 && writer->position <= writer->capacity && count <= writer->capacity - writer->position )
+    {
+        memcpy( writer->buffer + writer->position, bytes, count );
+    }
+    writer->position += count;
+}
+
+static void writeString( Writer * writer, char const * string )
+{
+    writeBytes( writer, string, strlen( string ) );
+}
+
+static void writeU8( Writer * writer, unsigned value )
+{
+    unsigned char byte = ( unsigned char ) value;
+    writeBytes( writer, &byte, 1 );
+}
+
+static void writeU32( Writer * writer, uint32_t value )
+{
+    unsigned char bytes[ 4 ];
+    bytes[ 0 ] = ( unsigned char ) ( value       );
+    bytes[ 1 ] = ( unsigned char ) ( value >>  8 );
+    bytes[ 2 ] = ( unsigned char ) ( value >> 16 );
+    bytes[ 3 ] = ( unsigned char ) ( value >> 24 );
+    writeBytes( writer, bytes, 4 );
+}
+
+static void patchU32( Writer * writer, size_t position, uint32_t value )
+{
+    Writer patcher;
+    patcher.buffer   = writer->buffer;
+    patcher.capacity = writer->capacity;
+    patcher.position = position;
+    writeU32( &patcher, value );
+}
+
+static void writeLengthPrefixedString( Writer * writer, char const * string )
+{
+    size_t length = strlen( string );
+    writeU32( writer, ( uint32_t ) length );
+    writeBytes( writer, string, length );
+}
+
+static void serializeBinary( Writer * writer, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    size_t start = writer->position;
+    size_t field;
+
+    writeBytes( writer, "HRP1", 4 );
+    writeU32( writer, 0 ); /* total length, patched below */
+
+    writeU8( writer, ( unsigned ) result->baseResult.state );
+    writeU8( writer, ( unsigned ) result->slipId );
+    writeU8( writer, result->uncertain );
+    writeU8( writer, result->conversionToEurPerformed );
+
+    writeU32( writer, ( uint32_t ) result->amountHrk );
+    writeU32( writer, ( uint32_t ) result->amountEur );
+
+    writeU32( writer, ( uint32_t ) result->dueDate.day );
+    writeU32( writer, ( uint32_t ) result->dueDate.month );
+    writeU32( writer, ( uint32_t ) result->dueDate.year );
+    writeU8( writer, result->dueDate.successfullyParsed != 0 );
+    writeU8( writer, result->dueDate.empty != 0 );
+
+    for ( field = 0; field < NUM_STRING_FIELDS; ++field )
+    {
+        writeLengthPrefixedString( writer, stringFieldValue( result, field ) );
+    }
+    writeLengthPrefixedString( writer, result->dueDate.originalString != NULL ? result->dueDate.originalString : "" );
+
+    patchU32( writer, start + 4, ( uint32_t ) ( writer->position - start ) );
+}
+
+static void writeJsonString( Writer * writer, char const * string )
+{
+    static char const hexDigits[] = "0123456789abcdef";
+    char const *      runStart    = string;
+    char const *      current;
+
+    writeU8( writer, '"' );
+    for ( current = string; *current != '\0'; ++current )
+    {
+        unsigned char c = ( unsigned char ) *current;
+        if ( c >= 0x20 && c != '"' && c != '\\' )
+        {
+            continue;
+        }
+
+        /* flush the run of characters that need no escaping */
+        writeBytes( writer, runStart, ( size_t ) ( current - runStart ) );
+        runStart = current + 1;
+
+        switch ( c )
+        {
+            case '"':  writeString( writer, "\\\"" ); break;
+            case '\\': writeString( writer, "\\\\" ); break;
+            case '\n': writeString( writer, "\\n"  ); break;
+            case '\r': writeString( writer, "\\r"  ); break;
+            case '\t': writeString( writer, "\\t"  ); break;
+            default:
+            {
+                char escape[ 6 ] = { '\\', 'u', '0', '0', 0, 0 };
+                escape[ 4 ] = hexDigits[ c >> 4 ];
+                escape[ 5 ] = hexDigits[ c & 0xF ];
+                writeBytes( writer, escape, 6 );
+                break;
+            }
+        }
+    }
+    writeBytes( writer, runStart, ( size_t ) ( current - runStart ) );
+    writeU8( writer, '"' );
+}
+
+static void writeJsonKey( Writer * writer, char const * key )
+{
+    writeU8( writer, '"' );
+    writeString( writer, key );
+    writeString( writer, "\":" );
+}
+
+static void writeJsonInt( Writer * writer, int value )
+{
+    char         digits[ 12 ];
+    size_t       start     = sizeof( digits );
+    /* negate in unsigned arithmetic so that INT_MIN does not overflow */
+    unsigned int magnitude = value < 0 ? 0u - ( unsigned int ) value : ( unsigned int ) value;
+
+    do
+    {
+        digits[ --start ] = ( char ) ( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while ( magnitude != 0 );
+
+    if ( value < 0 )
+    {
+        digits[ --start ] = '-';
+    }
+
+    writeBytes( writer, digits + start, sizeof( digits ) - start );
+}
+
+static void writeJsonBool( Writer * writer, int value )
+{
+    writeString( writer, value ? "true" : "false" );
+}
+
+static char const * resultStateName( MBRecognizerResultState state )
+{
+    switch ( state )
+    {
+        case MB_RECOGNIZER_RESULT_STATE_EMPTY:       return "EMPTY";
+        case MB_RECOGNIZER_RESULT_STATE_UNCERTAIN:   return "UNCERTAIN";
+        case MB_RECOGNIZER_RESULT_STATE_VALID:       return "VALID";
+        case MB_RECOGNIZER_RESULT_STATE_STAGE_VALID: return "STAGE_VALID";
+        default:                                     return "UNKNOWN";
+    }
+}
+
+static void serializeJson( Writer * writer, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    size_t field;
+
+    writeString( writer, "{\"state\":\"" );
+    writeString( writer, resultStateName( result->baseResult.state ) );
+    writeString( writer, "\",\"slipId\":\"" );
+    writeString( writer, result->slipId == MB_CROATIA_PAYMENT_BARCODE_TYPE_HUB1 ? "HUB1" : "HUB3" );
+    writeString( writer, "\"," );
+
+    writeJsonKey( writer, "uncertain" );
+    writeJsonBool( writer, result->uncertain );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "amountHrk" );
+    writeJsonInt( writer, result->amountHrk );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "amountEur" );
+    writeJsonInt( writer, result->amountEur );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "conversionToEurPerformed" );
+    writeJsonBool( writer, result->conversionToEurPerformed );
+
+    for ( field = 0; field < NUM_STRING_FIELDS; ++field )
+    {
+        writeU8( writer, ',' );
+        writeJsonKey( writer, stringFields[ field ].name );
+        writeJsonString( writer, stringFieldValue( result, field ) );
+    }
+
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "dueDate" );
+    writeU8( writer, '{' );
+    writeJsonKey( writer, "day" );
+    writeJsonInt( writer, result->dueDate.day );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "month" );
+    writeJsonInt( writer, result->dueDate.month );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "year" );
+    writeJsonInt( writer, result->dueDate.year );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "successfullyParsed" );
+    writeJsonBool( writer, result->dueDate.successfullyParsed );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "empty" );
+    writeJsonBool( writer, result->dueDate.empty );
+    writeU8( writer, ',' );
+    writeJsonKey( writer, "originalString" );
+    writeJsonString( writer, result->dueDate.originalString != NULL ? result->dueDate.originalString : "" );
+    writeString( writer, "}}" );
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultSerialize
+(
+    MBCroatiaBarcodePaymentRecognizerResult const * result,
+    char                                          * buffer,
+    size_t                                          capacity,
+    MBCroatiaPaymentResultFormat                    format,
+    size_t                                        * length
+)
+{
+    Writer writer;
+
+    if ( result == NULL || length == NULL || ( buffer == NULL && capacity != 0 ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    writer.buffer   = buffer;
+    writer.capacity = capacity;
+    writer.position = 0;
+
+    switch ( format )
+    {
+        case MB_CROATIA_PAYMENT_RESULT_FORMAT_BINARY:
+            serializeBinary( &writer, result );
+            break;
+        case MB_CROATIA_PAYMENT_RESULT_FORMAT_JSON:
+            serializeJson( &writer, result );
+            break;
+        default:
+            return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *length = writer.position;
+
+    return writer.position <= capacity ? MB_RECOGNIZER_ERROR_STATUS_SUCCESS : MB_RECOGNIZER_ERROR_STATUS_FAIL;
+}
+
+MBBool croatiaPaymentResultEqual( MBCroatiaBarcodePaymentRecognizerResult const * first, MBCroatiaBarcodePaymentRecognizerResult const * second )
+{
+    size_t field;
+
+    if ( first->amountHrk     != second->amountHrk     || first->amountEur      != second->amountEur      ||
+         first->dueDate.day   != second->dueDate.day   || first->dueDate.month  != second->dueDate.month  ||
+         first->dueDate.year  != second->dueDate.year )
+    {
+        return MB_FALSE;
+    }
+
+    for ( field = 0; field < NUM_STRING_FIELDS; ++field )
+    {
+        if ( strcmp( stringFieldValue( first, field ), stringFieldValue( second, field ) ) != 0 )
+        {
+            return MB_FALSE;
+        }
+    }
+
+    return MB_TRUE;
+}
+
+/* copies string into storage and advances storage, preserving NULL strings */
+static char const * copyString( char ** storage, char const * string )
+{
+    size_t size;
+    char * copy = *storage;
+
+    if ( string == NULL )
+    {
+        return NULL;
+    }
+
+    size = strlen( string ) + 1;
+    memcpy( copy, string, size );
+    *storage += size;
+
+    return copy;
+}
+
+MBRecognizerErrorStatus croatiaPaymentResultDetach( MBCroatiaDetachedPaymentResult ** detached, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    size_t   stringsSize = 0;
+    size_t   field;
+    char   * storage;
+
+    if ( detached == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *detached = NULL;
+
+    if ( result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    for ( field = 0; field < NUM_STRING_FIELDS; ++field )
+    {
+        if ( rawStringFieldValue( result, field ) != NULL )
+        {
+            stringsSize += strlen( rawStringFieldValue( result, field ) ) + 1;
+        }
+    }
+    if ( result->dueDate.originalString != NULL )
+    {
+        stringsSize += strlen( result->dueDate.originalString ) + 1;
+    }
+
+    *detached = ( MBCroatiaDetachedPaymentResult * ) malloc( sizeof( MBCroatiaDetachedPaymentResult ) + stringsSize );
+    if ( *detached == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    ( *detached )->result = *result;
+
+    storage = ( char * ) ( *detached + 1 );
+    for ( field = 0; field < NUM_STRING_FIELDS; ++field )
+    {
+        char const ** copiedField = mutableStringField( &( *detached )->result, field );
+        *copiedField = copyString( &storage, *copiedField );
+    }
+    ( *detached )->result.dueDate.originalString = copyString( &storage, result->dueDate.originalString );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaDetachedPaymentResultGet( MBCroatiaDetachedPaymentResult const * detached )
+{
+    return &detached->result;
+}
+
+MBRecognizerErrorStatus croatiaDetachedPaymentResultDelete( MBCroatiaDetachedPaymentResult ** detached )
+{
+    if ( detached == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    free( *detached );
+    *detached = NULL;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
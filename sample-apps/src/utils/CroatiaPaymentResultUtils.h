@@ -0,0 +1,157 @@
+/**
+ * @file CroatiaPaymentResultUtils.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_RESULT_UTILS_H_
+#define CROATIA_PAYMENT_RESULT_UTILS_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @enum MBCroatiaPaymentResultFormat
+ * @brief Formats into which MBCroatiaBarcodePaymentRecognizerResult can be serialized.
+ */
+enum MBCroatiaPaymentResultFormat
+{
+    /**
+     * Compact little-endian binary format:
+     *  - 4 bytes magic "HRP1"
+     *  - uint32 total length of the record, including the magic
+     *  - uint8 baseResult.state, uint8 slipId, uint8 uncertain, uint8 conversionToEurPerformed
+     *  - int32 amountHrk, int32 amountEur
+     *  - int32 dueDate.day, int32 dueDate.month, int32 dueDate.year, uint8 dueDate.successfullyParsed, uint8 dueDate.empty
+     *  - 16 length-prefixed strings (uint32 length followed by bytes, without terminating zero), in order: payerName,
+     *    payerAddress, payerDetailedAddress, recipientName, recipientAddress, recipientDetailedAddress, accountNumber,
+     *    bankCode, iban, referenceModel, reference, purposeCode, paymentDescription, paymentDescriptionCode,
+     *    optionalData and dueDate.originalString. NULL strings are stored as empty strings.
+     */
+    MB_CROATIA_PAYMENT_RESULT_FORMAT_BINARY,
+
+    /** Single JSON object whose keys are names of the result's fields. Output is not zero-terminated. */
+    MB_CROATIA_PAYMENT_RESULT_FORMAT_JSON
+};
+
+/**
+ * @brief Typedef for MBCroatiaPaymentResultFormat enum.
+ */
+typedef enum MBCroatiaPaymentResultFormat MBCroatiaPaymentResultFormat;
+
+/**
+ * @brief Serializes the payment result directly into caller provided buffer, without any intermediate allocations.
+ *
+ * The serialized record does not reference any recognizer-owned memory, so it remains valid after the recognizer
+ * processes the next image.
+ *
+ * Example:
+ * @code
+ *  char   buffer[ 4096 ];
+ *  size_t length;
+ *
+ *  if ( croatiaPaymentResultSerialize( &result, buffer, sizeof( buffer ), MB_CROATIA_PAYMENT_RESULT_FORMAT_JSON, &length ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS ) {
+ *      // send first length bytes of buffer
+ *  }
+ * @endcode
+ *
+ * @param result    Result that will be serialized.
+ * @param buffer    Buffer into which result will be written. May be NULL if capacity is 0.
+ * @param capacity  Size of the buffer, in bytes.
+ * @param format    Format of the serialized record.
+ * @param length    Receives the length of the serialized record. If buffer is too small, receives the required capacity.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_FAIL is returned if buffer is too small, in which case
+ *         the contents of the buffer are unspecified.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultSerialize
+(
+    MBCroatiaBarcodePaymentRecognizerResult const * result,
+    char                                          * buffer,
+    size_t                                          capacity,
+    MBCroatiaPaymentResultFormat                    format,
+    size_t                                        * length
+);
+
+/**
+ * @brief Compares payment data of two results, i.e. whether they describe the same payment.
+ * Only amounts, due date and string fields are compared; state, uncertainty and slip identifier are ignored.
+ * NULL strings are considered equal to empty strings.
+ * @param first     First result.
+ * @param second    Second result.
+ * @return MB_TRUE if results carry the same payment data.
+ */
+MBBool croatiaPaymentResultEqual( MBCroatiaBarcodePaymentRecognizerResult const * first, MBCroatiaBarcodePaymentRecognizerResult const * second );
+
+/**
+ * @struct MBCroatiaDetachedPaymentResult
+ * @brief Payment result that owns all of its strings and is independent of the recognizer that produced it.
+ *
+ * The result and all its strings are stored in a single allocation, so the object can be handed over to another
+ * thread simply by passing its pointer, while the recognizer immediately continues with the next image.
+ */
+struct MBCroatiaDetachedPaymentResult;
+
+/**
+ * @brief Typedef for MBCroatiaDetachedPaymentResult structure.
+ */
+typedef struct MBCroatiaDetachedPaymentResult MBCroatiaDetachedPaymentResult;
+
+/**
+ * @memberof MBCroatiaDetachedPaymentResult
+ * @brief Creates MBCroatiaDetachedPaymentResult that holds a copy of the given result.
+ *
+ * Example:
+ * @code
+ *  MBCroatiaPdf417PaymentRecognizerResult result;
+ *  MBCroatiaDetachedPaymentResult *detached;
+ *
+ *  croatiaPdf417PaymentRecognizerResult( &result, pdf417Recognizer );
+ *  if ( croatiaPaymentResultDetach( &detached, &result ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS ) {
+ *      // pass detached to another thread, which will call croatiaDetachedPaymentResultDelete when done
+ *  }
+ *  // pdf417Recognizer can now be used for the next image
+ * @endcode
+ *
+ * @param detached  Pointer to pointer referencing the created object, set to NULL if error occured.
+ * @param result    Result obtained from the recognizer. Its strings are copied with a single allocation.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultDetach( MBCroatiaDetachedPaymentResult ** detached, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @memberof MBCroatiaDetachedPaymentResult
+ * @brief Returns the result held by the detached object. All pointers in the returned structure remain valid
+ * until the detached object is destroyed with ::croatiaDetachedPaymentResultDelete.
+ * @param detached  Detached result of interest.
+ * @return held result.
+ */
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaDetachedPaymentResultGet( MBCroatiaDetachedPaymentResult const * detached );
+
+/**
+ * @memberof MBCroatiaDetachedPaymentResult
+ * @brief Destroys the given MBCroatiaDetachedPaymentResult and sets pointer to it to NULL.
+ * @param detached  Pointer to pointer to MBCroatiaDetachedPaymentResult that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaDetachedPaymentResultDelete( MBCroatiaDetachedPaymentResult ** detached );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
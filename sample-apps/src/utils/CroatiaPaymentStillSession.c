@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentStillSession.h"
+#include "CroatiaPaymentFieldConfidence.h"
+#include "CroatiaPaymentResultUtils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct MBCroatiaPaymentStillSession
+{
+    /* merged result of all images so far, NULL before the first image */
+    MBCroatiaDetachedPaymentResult * merged;
+};
+
+static int isCertain( MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    return result->baseResult.state == MB_RECOGNIZER_RESULT_STATE_VALID && !result->uncertain;
+}
+
+/* sum of confidences of the given fields, so that fields verified together are compared together */
+static int groupStrength( MBCroatiaPaymentFieldConfidences const * confidences, unsigned fieldMask )
+{
+    int strength = 0;
+    int field;
+
+    for ( field = 0; field < MB_CROATIA_PAYMENT_FIELD_COUNT; ++field )
+    {
+        if ( fieldMask & MB_CROATIA_PAYMENT_FIELD_BIT( field ) )
+        {
+            strength += ( int ) confidences->fields[ field ];
+        }
+    }
+
+    return strength;
+}
+
+typedef enum FieldChoice
+{
+    FIELD_CHOICE_FIRST,
+    FIELD_CHOICE_SECOND,
+
+    /* equally strong, but different values, so neither can be trusted */
+    FIELD_CHOICE_CONFLICT
+} FieldChoice;
+
+static FieldChoice chooseField( MBCroatiaPaymentFieldConfidences const * first, MBCroatiaPaymentFieldConfidences const * second, unsigned fieldMask, int valuesDiffer )
+{
+    int firstStrength  = groupStrength( first,  fieldMask );
+    int secondStrength = groupStrength( second, fieldMask );
+
+    if ( secondStrength > firstStrength )
+    {
+        return FIELD_CHOICE_SECOND;
+    }
+    if ( secondStrength == firstStrength && valuesDiffer )
+    {
+        return FIELD_CHOICE_CONFLICT;
+    }
+    return FIELD_CHOICE_FIRST;
+}
+
+static int stringsDiffer( char const * first, char const * second )
+{
+    return strcmp( first != NULL ? first : "", second != NULL ? second : "" ) != 0;
+}
+
+/* conflicting field is cleared, so that it is reported as missing and a later image can fill it in */
+static void mergeString( char const ** merged, char const * second, FieldChoice choice )
+{
+    if ( choice == FIELD_CHOICE_SECOND )
+    {
+        *merged = second;
+    }
+    else if ( choice == FIELD_CHOICE_CONFLICT )
+    {
+        *merged = "";
+    }
+}
+
+#define FIELD( field ) MB_CROATIA_PAYMENT_FIELD_BIT( MB_CROATIA_PAYMENT_FIELD_##field )
+
+#define MERGE_STRING( field, fieldMask ) \
+    mergeString( &merged->field, second->field, chooseField( &firstConfidences, &secondConfidences, fieldMask, stringsDiffer( first->field, second->field ) ) )
+
+MBRecognizerErrorStatus croatiaPaymentResultMergeFields
+(
+    MBCroatiaBarcodePaymentRecognizerResult       * merged,
+    MBCroatiaBarcodePaymentRecognizerResult const * first,
+    MBCroatiaBarcodePaymentRecognizerResult const * second
+)
+{
+    MBCroatiaPaymentFieldConfidences firstConfidences;
+    MBCroatiaPaymentFieldConfidences secondConfidences;
+    FieldChoice                      choice;
+
+    if ( merged == NULL || first == NULL || second == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* complete decode is never mixed with misread data, and empty result has nothing to contribute */
+    if ( isCertain( first ) || second->baseResult.state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+    {
+        *merged = *first;
+        return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+    }
+    if ( isCertain( second ) || first->baseResult.state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+    {
+        *merged = *second;
+        return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+    }
+
+    *merged = *first;
+
+    croatiaPaymentResultFieldConfidences( &firstConfidences, first );
+    croatiaPaymentResultFieldConfidences( &secondConfidences, second );
+
+    choice = chooseField( &firstConfidences, &secondConfidences, FIELD( AMOUNT ),
+                          first->amountHrk != second->amountHrk || first->amountEur != second->amountEur );
+    if ( choice == FIELD_CHOICE_SECOND )
+    {
+        merged->amountHrk                = second->amountHrk;
+        merged->amountEur                = second->amountEur;
+        merged->conversionToEurPerformed = second->conversionToEurPerformed;
+    }
+    else if ( choice == FIELD_CHOICE_CONFLICT )
+    {
+        merged->amountHrk                = 0;
+        merged->amountEur                = 0;
+        merged->conversionToEurPerformed = MB_FALSE;
+    }
+
+    MERGE_STRING( payerName,                FIELD( PAYER_NAME ) );
+    MERGE_STRING( payerAddress,             FIELD( PAYER_ADDRESS ) );
+    MERGE_STRING( payerDetailedAddress,     FIELD( PAYER_DETAILED_ADDRESS ) );
+    MERGE_STRING( recipientName,            FIELD( RECIPIENT_NAME ) );
+    MERGE_STRING( recipientAddress,         FIELD( RECIPIENT_ADDRESS ) );
+    MERGE_STRING( recipientDetailedAddress, FIELD( RECIPIENT_DETAILED_ADDRESS ) );
+    MERGE_STRING( purposeCode,              FIELD( PURPOSE_CODE ) );
+    MERGE_STRING( paymentDescription,       FIELD( PAYMENT_DESCRIPTION ) );
+    MERGE_STRING( paymentDescriptionCode,   FIELD( PAYMENT_DESCRIPTION_CODE ) );
+
+    choice = chooseField( &firstConfidences, &secondConfidences, FIELD( IBAN ) | FIELD( BANK_CODE ) | FIELD( ACCOUNT_NUMBER ),
+                          stringsDiffer( first->iban, second->iban ) );
+    mergeString( &merged->iban,          second->iban,          choice );
+    mergeString( &merged->bankCode,      second->bankCode,      choice );
+    mergeString( &merged->accountNumber, second->accountNumber, choice );
+
+    choice = chooseField( &firstConfidences, &secondConfidences, FIELD( REFERENCE_MODEL ) | FIELD( REFERENCE ),
+                          stringsDiffer( first->referenceModel, second->referenceModel ) || stringsDiffer( first->reference, second->reference ) );
+    mergeString( &merged->referenceModel, second->referenceModel, choice );
+    mergeString( &merged->reference,      second->reference,      choice );
+
+    choice = chooseField( &firstConfidences, &secondConfidences, FIELD( DUE_DATE ),
+                          first->dueDate.day != second->dueDate.day || first->dueDate.month != second->dueDate.month || first->dueDate.year != second->dueDate.year );
+    if ( choice == FIELD_CHOICE_SECOND )
+    {
+        merged->dueDate = second->dueDate;
+    }
+    else if ( choice == FIELD_CHOICE_CONFLICT )
+    {
+        memset( &merged->dueDate, 0, sizeof( merged->dueDate ) );
+        merged->dueDate.empty = MB_TRUE;
+    }
+
+    if ( merged->optionalData == NULL || merged->optionalData[ 0 ] == '\0' )
+    {
+        merged->optionalData = second->optionalData;
+    }
+
+    /*
+     * neither result is certain, and fields without checksum, such as the amount, cannot be verified by merging;
+     * the merged result is therefore never certain, no matter how complete it looks
+     */
+    merged->baseResult.state = MB_RECOGNIZER_RESULT_STATE_UNCERTAIN;
+    merged->uncertain        = MB_TRUE;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+#undef MERGE_STRING
+#undef FIELD
+
+MBRecognizerErrorStatus croatiaPaymentStillSessionCreate( MBCroatiaPaymentStillSession ** session )
+{
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *session = ( MBCroatiaPaymentStillSession * ) calloc( 1, sizeof( MBCroatiaPaymentStillSession ) );
+    if ( *session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentStillSessionAddResult( MBCroatiaPaymentStillSession * session, MBCroatiaBarcodePaymentRecognizerResult const * result )
+{
+    MBCroatiaBarcodePaymentRecognizerResult merged;
+    MBCroatiaDetachedPaymentResult        * detached;
+    MBRecognizerErrorStatus                 status;
+
+    if ( session == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( session->merged == NULL )
+    {
+        return croatiaPaymentResultDetach( &session->merged, result );
+    }
+
+    /* merged result points into both, so it is detached before the previous copy is released */
+    status = croatiaPaymentResultMergeFields( &merged, croatiaDetachedPaymentResultGet( session->merged ), result );
+    if ( status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        status = croatiaPaymentResultDetach( &detached, &merged );
+    }
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    croatiaDetachedPaymentResultDelete( &session->merged );
+    session->merged = detached;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerResultState croatiaPaymentStillSessionRecognize
+(
+    MBCroatiaPaymentStillSession            * session,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+)
+{
+    MBCroatiaBarcodePaymentRecognizerResult imageResult;
+
+    if ( session == NULL || recognizerRunner == NULL || image == NULL || result == NULL )
+    {
+        return MB_RECOGNIZER_RESULT_STATE_EMPTY;
+    }
+
+    if ( session->merged == NULL )
+    {
+        recognizerRunnerReset( recognizerRunner );
+    }
+
+    /* as video frame, so that recognizers combine it with the previous images of the session */
+    recognizerRunnerRecognizeFromImage( recognizerRunner, image, MB_TRUE, NULL );
+
+    memset( &imageResult, 0, sizeof( MBCroatiaBarcodePaymentRecognizerResult ) );
+    if ( pdf417Recognizer != NULL )
+    {
+        croatiaPdf417PaymentRecognizerResult( &imageResult, pdf417Recognizer );
+    }
+    if ( qrRecognizer != NULL && imageResult.baseResult.state == MB_RECOGNIZER_RESULT_STATE_EMPTY )
+    {
+        croatiaQrPaymentRecognizerResult( &imageResult, qrRecognizer );
+    }
+
+    if ( croatiaPaymentStillSessionAddResult( session, &imageResult ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        /* merged copy could not be made, so report the image alone */
+        *result = imageResult;
+        return result->baseResult.state;
+    }
+
+    *result = *croatiaDetachedPaymentResultGet( session->merged );
+    return result->baseResult.state;
+}
+
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentStillSessionResult( MBCroatiaPaymentStillSession const * session )
+{
+    if ( session == NULL || session->merged == NULL )
+    {
+        return NULL;
+    }
+
+    return croatiaDetachedPaymentResultGet( session->merged );
+}
+
+MBRecognizerErrorStatus croatiaPaymentStillSessionReset( MBCroatiaPaymentStillSession * session )
+{
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    croatiaDetachedPaymentResultDelete( &session->merged );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus croatiaPaymentStillSessionDelete( MBCroatiaPaymentStillSession ** session )
+{
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *session != NULL )
+    {
+        croatiaDetachedPaymentResultDelete( &( *session )->merged );
+        free( *session );
+        *session = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
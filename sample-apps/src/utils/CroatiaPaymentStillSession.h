@@ -0,0 +1,144 @@
+/**
+ * @file CroatiaPaymentStillSession.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_STILL_SESSION_H_
+#define CROATIA_PAYMENT_STILL_SESSION_H_
+
+#include <Recognizer/PhotoPay/Croatia/CroatiaBarcodePaymentRecognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Merges two results of the same slip field by field, taking every field from the result in which it is stronger.
+ *
+ * Strength of fields is measured by ::croatiaPaymentResultFieldConfidences. Fields that are verified together are
+ * merged together: IBAN with bank code and account number, and reference model with reference. Fields of equal
+ * strength but different values conflict: neither value can be trusted, so the field is cleared and reported as
+ * missing, which also lets a later image fill it in. If either result is valid and certain, it is taken as a whole,
+ * so that a complete decode is never mixed with misread data. Otherwise the merged result is always uncertain, because
+ * fields without a checksum, such as the amount, cannot be verified by combining uncertain decodes.
+ *
+ * @param merged    Receives the merged result, whose pointers point into the given results.
+ * @param first     Earlier result.
+ * @param second    Later result.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentResultMergeFields
+(
+    MBCroatiaBarcodePaymentRecognizerResult       * merged,
+    MBCroatiaBarcodePaymentRecognizerResult const * first,
+    MBCroatiaBarcodePaymentRecognizerResult const * second
+);
+
+/**
+ * @struct MBCroatiaPaymentStillSession
+ * @brief Combines several still images of the same slip, explicitly grouped by the caller, into a single result.
+ *
+ * Images of the session are given to the recognizer runner as consecutive video frames, without resetting it in
+ * between, so that the recognizers can combine partially readable symbols the same way they do in video. Results of
+ * individual images are additionally merged field by field with ::croatiaPaymentResultMergeFields, which completes
+ * the result even when the images differ too much, i.e. in resolution, to be combined by the recognizers.
+ * A second photo of a damaged slip therefore continues from what the first one decoded, instead of starting from zero.
+ * Merged result becomes certain only when the recognizers produce a certain result for one of the images.
+ *
+ * Session keeps a single merged copy of the result, so its memory does not grow with the number of images.
+ * Session must not be used from multiple threads at the same time.
+ */
+struct MBCroatiaPaymentStillSession;
+
+/**
+ * @brief Typedef for MBCroatiaPaymentStillSession structure.
+ */
+typedef struct MBCroatiaPaymentStillSession MBCroatiaPaymentStillSession;
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Allocates and initializes new MBCroatiaPaymentStillSession object.
+ * @param session   Pointer to pointer referencing the created object.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentStillSessionCreate( MBCroatiaPaymentStillSession ** session );
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Recognizes the next image of the slip and merges its result into the result of the session.
+ *
+ * The runner is reset before the first image of the session and must not recognize any other image until the
+ * session is reset or deleted, otherwise recognizers would combine images of different slips.
+ *
+ * @param session           Session of interest.
+ * @param recognizerRunner  Recognizer runner containing the given recognizers.
+ * @param pdf417Recognizer  PDF417 payment recognizer in the runner, or NULL.
+ * @param qrRecognizer      QR payment recognizer in the runner, or NULL.
+ * @param image             Image of the slip.
+ * @param result            Receives the merged result of all images of the session. Pointers in the structure remain
+ *                          valid until the next call which modifies the session.
+ * @return state of the merged result.
+ */
+MBRecognizerResultState croatiaPaymentStillSessionRecognize
+(
+    MBCroatiaPaymentStillSession            * session,
+    MBRecognizerRunner                      * recognizerRunner,
+    MBCroatiaPdf417PaymentRecognizer const  * pdf417Recognizer,
+    MBCroatiaQrPaymentRecognizer     const  * qrRecognizer,
+    MBRecognizerImage                const  * image,
+    MBCroatiaBarcodePaymentRecognizerResult * result
+);
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Merges result obtained elsewhere, i.e. by another runner or by MBCroatiaPaymentPayloadParser, into the result
+ * of the session.
+ * @param session   Session of interest.
+ * @param result    Result of another image of the same slip.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentStillSessionAddResult( MBCroatiaPaymentStillSession * session, MBCroatiaBarcodePaymentRecognizerResult const * result );
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Returns the merged result of all images of the session.
+ * @param session   Session of interest.
+ * @return merged result, valid until the next call which modifies the session, or NULL if no image was added yet.
+ */
+MBCroatiaBarcodePaymentRecognizerResult const * croatiaPaymentStillSessionResult( MBCroatiaPaymentStillSession const * session );
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Discards the merged result, so that the session can be used for another slip.
+ * @param session   Session of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentStillSessionReset( MBCroatiaPaymentStillSession * session );
+
+/**
+ * @memberof MBCroatiaPaymentStillSession
+ * @brief Destroys the given MBCroatiaPaymentStillSession and sets pointer to it to NULL.
+ * @param session   Pointer to pointer to MBCroatiaPaymentStillSession that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus croatiaPaymentStillSessionDelete( MBCroatiaPaymentStillSession ** session );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
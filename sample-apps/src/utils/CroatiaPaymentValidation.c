@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "CroatiaPaymentValidation.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define IBAN_MIN_LENGTH           15
+#define IBAN_MAX_LENGTH           34
+#define CROATIAN_IBAN_LENGTH      21
+#define REFERENCE_MAX_LENGTH      22
+#define REFERENCE_MAX_HYPHENS     2
+
+static int isUpperLetter( char c )
+{
+    return c >= 'A' && c <= 'Z';
+}
+
+static int isDigit( char c )
+{
+    return c >= '0' && c <= '9';
+}
+
+/*
+ * For mod-97 checksum, every IBAN character is replaced with its value (digits 0-9, letters 10-35), so the number
+ * is extended by one decimal digit for digits and by two decimal digits for letters. Remainder is reduced modulo 97
+ * only once per 8 characters.
+ */
+static uint64_t accumulateMod97( uint64_t remainder, char const * characters, size_t count, int * invalid )
+{
+    size_t i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        unsigned digit  = ( unsigned ) ( characters[ i ] - '0' );
+        unsigned letter = ( unsigned ) ( characters[ i ] - 'A' );
+        int      isDigitCharacter = digit < 10;
+
+        *invalid |= !isDigitCharacter && letter >= 26;
+        remainder = isDigitCharacter ? remainder * 10 + digit : remainder * 100 + letter + 10;
+
+        /* remainder < 97 * 100^8 < 2^64 */
+        if ( ( i & 7 ) == 7 )
+        {
+            remainder %= 97;
+        }
+    }
+
+    return remainder % 97;
+}
+
+MBBool ibanIsValid( char const * iban )
+{
+    size_t   length;
+    uint64_t remainder;
+    int      invalid = 0;
+
+    if ( iban == NULL )
+    {
+        return MB_FALSE;
+    }
+
+    length = strlen( iban );
+    if ( length < IBAN_MIN_LENGTH || length > IBAN_MAX_LENGTH ||
+         !isUpperLetter( iban[ 0 ] ) || !isUpperLetter( iban[ 1 ] ) || !isDigit( iban[ 2 ] ) || !isDigit( iban[ 3 ] ) )
+    {
+        return MB_FALSE;
+    }
+
+    if ( iban[ 0 ] == 'H' && iban[ 1 ] == 'R' && length != CROATIAN_IBAN_LENGTH )
+    {
+        return MB_FALSE;
+    }
+
+    /* checksum is computed over BBAN followed by country code and check digits */
+    remainder = accumulateMod97( 0, iban + 4, length - 4, &invalid );
+    remainder = accumulateMod97( remainder, iban, 4, &invalid );
+
+    return !invalid && remainder == 1 ? MB_TRUE : MB_FALSE;
+}
+
+size_t ibanValidateBatch( char const * const * ibans, size_t count, MBBool * valid )
+{
+    size_t numValid = 0;
+    size_t i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        MBBool isValid = ibanIsValid( ibans[ i ] );
+        numValid += isValid;
+        if ( valid != NULL )
+        {
+            valid[ i ] = isValid;
+        }
+    }
+
+    return numValid;
+}
+
+MBBool croatiaReferenceIsValid( char const * referenceModel, char const * reference )
+{
+    size_t length = 0;
+    int    hyphens = 0;
+    char   previous = '-';
+
+    if ( referenceModel == NULL || strlen( referenceModel ) != 4 || referenceModel[ 0 ] != 'H' || referenceModel[ 1 ] != 'R' ||
+         !isDigit( referenceModel[ 2 ] ) || !isDigit( referenceModel[ 3 ] ) )
+    {
+        return MB_FALSE;
+    }
+
+    if ( reference == NULL )
+    {
+        reference = "";
+    }
+
+    if ( strcmp( referenceModel, "HR99" ) == 0 )
+    {
+        return reference[ 0 ] == '\0' ? MB_TRUE : MB_FALSE;
+    }
+
+    for ( ; reference[ length ] != '\0'; ++length )
+    {
+        char c = reference[ length ];
+        if ( c == '-' )
+        {
+            /* parts separated by hyphens must not be empty */
+            if ( previous == '-' || ++hyphens > REFERENCE_MAX_HYPHENS )
+            {
+                return MB_FALSE;
+            }
+        }
+        else if ( !isDigit( c ) )
+        {
+            return MB_FALSE;
+        }
+        previous = c;
+    }
+
+    return length <= REFERENCE_MAX_LENGTH && ( length == 0 || previous != '-' ) ? MB_TRUE : MB_FALSE;
+}
+
+size_t croatiaReferenceValidateBatch( char const * const * referenceModels, char const * const * references, size_t count, MBBool * valid )
+{
+    size_t numValid = 0;
+    size_t i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        MBBool isValid = croatiaReferenceIsValid( referenceModels[ i ], references[ i ] );
+        numValid += isValid;
+        if ( valid != NULL )
+        {
+            valid[ i ] = isValid;
+        }
+    }
+
+    return numValid;
+}
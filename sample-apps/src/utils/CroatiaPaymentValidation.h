@@ -0,0 +1,72 @@
+/**
+ * @file CroatiaPaymentValidation.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef CROATIA_PAYMENT_VALIDATION_H_
+#define CROATIA_PAYMENT_VALIDATION_H_
+
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Checks whether the given string is a valid IBAN in electronic format (without spaces).
+ * Country code, check digits, allowed characters, length (exact length for Croatian IBANs) and
+ * ISO 13616 mod-97 checksum are verified.
+ * @param iban  Zero-terminated IBAN. NULL is treated as invalid.
+ * @return MB_TRUE if IBAN is valid.
+ */
+MBBool ibanIsValid( char const * iban );
+
+/**
+ * @brief Validates array of IBANs. @see ::ibanIsValid
+ * Checksums are computed without per-character division, with a single modulo reduction per eight characters,
+ * so validating large arrays costs a few nanoseconds per IBAN.
+ * @param ibans Array of zero-terminated IBANs.
+ * @param count Number of IBANs in the array.
+ * @param valid Array of count elements that will receive validity of each IBAN. May be NULL if only number
+ *              of valid IBANs is needed.
+ * @return number of valid IBANs.
+ */
+size_t ibanValidateBatch( char const * const * ibans, size_t count, MBBool * valid );
+
+/**
+ * @brief Checks whether the given reference is syntactically valid for the given HUB3 reference model.
+ * Model must be "HR" followed by two digits. Reference may contain at most 22 characters - digits and at most two
+ * hyphens that separate non-empty parts. Model HR99 requires empty reference. Control digits specific to individual
+ * models are not verified.
+ * @param referenceModel    Zero-terminated reference model (i.e. "HR01"). NULL is treated as invalid.
+ * @param reference         Zero-terminated reference. NULL is treated as empty reference.
+ * @return MB_TRUE if reference is valid.
+ */
+MBBool croatiaReferenceIsValid( char const * referenceModel, char const * reference );
+
+/**
+ * @brief Validates array of references. @see ::croatiaReferenceIsValid
+ * @param referenceModels   Array of zero-terminated reference models.
+ * @param references        Array of zero-terminated references.
+ * @param count             Number of elements in both arrays.
+ * @param valid             Array of count elements that will receive validity of each reference, or NULL.
+ * @return number of valid references.
+ */
+size_t croatiaReferenceValidateBatch( char const * const * referenceModels, char const * const * references, size_t count, MBBool * valid );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "FrameQuality.h"
+#include "RecognizerImageUtils.h"
+
+#include <stddef.h>
+
+#define DEFAULT_MIN_SHARPNESS      0.2f
+#define DEFAULT_MAX_GLARE_FRACTION 0.05f
+#define DEFAULT_MIN_MEAN_LUMA      40
+#define DEFAULT_MAX_MEAN_LUMA      225
+
+#define THUMBNAIL_WIDTH  32
+#define THUMBNAIL_HEIGHT 24
+
+/* thumbnail pixels at least this bright are considered saturated */
+#define GLARE_LUMA 250
+
+/* sharpness is measured on GRID_COLUMNS x GRID_ROWS horizontal and vertical runs of RUN_LENGTH pixels */
+#define GRID_COLUMNS 16
+#define GRID_ROWS    12
+#define RUN_LENGTH   8
+
+/* distance of the far neighbour; edges blurred over this many pixels have sharpness 0 */
+#define FAR_DISTANCE 4
+
+/* differences to the far neighbour below this are considered noise, not edges */
+#define MIN_EDGE_CONTRAST 8
+
+void frameQualitySettingsDefaultInit( MBFrameQualitySettings * settings )
+{
+    settings->minSharpness     = DEFAULT_MIN_SHARPNESS;
+    settings->maxGlareFraction = DEFAULT_MAX_GLARE_FRACTION;
+    settings->minMeanLuma      = DEFAULT_MIN_MEAN_LUMA;
+    settings->maxMeanLuma      = DEFAULT_MAX_MEAN_LUMA;
+}
+
+char const * frameQualityVerdictToString( MBFrameQualityVerdict verdict )
+{
+    switch ( verdict )
+    {
+        case MB_FRAME_QUALITY_VERDICT_OK:
+            return "OK";
+        case MB_FRAME_QUALITY_VERDICT_UNDEREXPOSED:
+            return "UNDEREXPOSED";
+        case MB_FRAME_QUALITY_VERDICT_OVEREXPOSED:
+            return "OVEREXPOSED";
+        case MB_FRAME_QUALITY_VERDICT_GLARE:
+            return "GLARE";
+        case MB_FRAME_QUALITY_VERDICT_BLURRED:
+            return "BLURRED";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+/*
+ * Accumulates squared differences of luma to the direct and to the far neighbour along a run of pixels, where step is
+ * the distance between neighbouring pixels in bytes. Only positions with enough contrast to the far neighbour are
+ * accumulated, so that sensor noise in flat areas does not look like sharp detail.
+ */
+static void accumulateRun( MBByte const * start, ptrdiff_t step, int bytesPerPixel, long * nearSum, long * farSum )
+{
+    int i;
+
+    for ( i = 0; i < RUN_LENGTH; ++i )
+    {
+        MBByte const * pixel    = start + i * step;
+        int            luma     = recognizerImagePixelLuma( pixel, 0, bytesPerPixel );
+        int            nearDiff = recognizerImagePixelLuma( pixel + step, 0, bytesPerPixel ) - luma;
+        int            farDiff  = recognizerImagePixelLuma( pixel + FAR_DISTANCE * step, 0, bytesPerPixel ) - luma;
+
+        if ( farDiff >= MIN_EDGE_CONTRAST || farDiff <= -MIN_EDGE_CONTRAST )
+        {
+            *nearSum += nearDiff * nearDiff;
+            *farSum  += farDiff  * farDiff;
+        }
+    }
+}
+
+/*
+ * Across an edge of height h blurred over w >= FAR_DISTANCE pixels, every difference to the direct neighbour is h / w
+ * and to the far neighbour FAR_DISTANCE * h / w, so sum of squares of the latter, divided by FAR_DISTANCE^2, equals the
+ * former. Sharp edge concentrates the whole height in a single direct difference, making its square up to FAR_DISTANCE
+ * times larger. The ratio of the two sums therefore goes from 1 for blurred to FAR_DISTANCE for sharp edges,
+ * regardless of their contrast, and is mapped to [0, 1].
+ */
+static float measureSharpness( MBByte const * pixels, int width, int height, int bytesPerRow, int bytesPerPixel )
+{
+    int    span        = RUN_LENGTH + FAR_DISTANCE;
+    int    pixelStride = bytesPerPixel > 1 ? bytesPerPixel : 1;
+    long   nearSum     = 0;
+    long   farSum      = 0;
+    int    gx, gy;
+    double ratio;
+
+    if ( width <= span || height <= span )
+    {
+        return 0.f;
+    }
+
+    for ( gy = 0; gy < GRID_ROWS; ++gy )
+    {
+        int y = ( 2 * gy + 1 ) * ( height - span ) / ( 2 * GRID_ROWS );
+
+        for ( gx = 0; gx < GRID_COLUMNS; ++gx )
+        {
+            int            x     = ( 2 * gx + 1 ) * ( width - span ) / ( 2 * GRID_COLUMNS );
+            MBByte const * start = pixels + ( size_t ) y * bytesPerRow + ( size_t ) x * pixelStride;
+
+            accumulateRun( start, pixelStride, bytesPerPixel, &nearSum, &farSum );
+            accumulateRun( start, bytesPerRow, bytesPerPixel, &nearSum, &farSum );
+        }
+    }
+
+    if ( farSum == 0 )
+    {
+        return 0.f;
+    }
+
+    ratio = ( double ) nearSum * ( FAR_DISTANCE * FAR_DISTANCE ) / farSum;
+    ratio = ( ratio - 1. ) / ( FAR_DISTANCE - 1 );
+
+    return ratio < 0. ? 0.f : ratio > 1. ? 1.f : ( float ) ratio;
+}
+
+MBRecognizerErrorStatus frameQualityEvaluate( MBFrameQuality * quality, MBRecognizerImage const * frame, MBFrameQualitySettings const * settings )
+{
+    MBFrameQualitySettings  defaultSettings;
+    MBByte                  thumbnail[ THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT ];
+    MBRecognizerErrorStatus status;
+    long                    lumaSum   = 0;
+    int                     saturated = 0;
+    int                     i;
+
+    if ( quality == NULL || frame == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( settings == NULL )
+    {
+        frameQualitySettingsDefaultInit( &defaultSettings );
+        settings = &defaultSettings;
+    }
+
+    status = recognizerImageSampleLuma( frame, thumbnail, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    for ( i = 0; i < THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT; ++i )
+    {
+        lumaSum += thumbnail[ i ];
+        if ( thumbnail[ i ] >= GLARE_LUMA )
+        {
+            ++saturated;
+        }
+    }
+
+    quality->meanLuma      = ( int ) ( lumaSum / ( THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT ) );
+    quality->glareFraction = ( float ) saturated / ( THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT );
+    quality->sharpness     = measureSharpness
+    (
+        recognizerImageGetRawBytes( frame ),
+        recognizerImageGetWidth( frame ),
+        recognizerImageGetHeight( frame ),
+        recognizerImageGetBytesPerRow( frame ),
+        recognizerImageRawTypeBytesPerPixel( recognizerImageGetRawImageType( frame ) )
+    );
+
+    if ( quality->meanLuma < settings->minMeanLuma )
+    {
+        quality->verdict = MB_FRAME_QUALITY_VERDICT_UNDEREXPOSED;
+    }
+    else if ( quality->meanLuma > settings->maxMeanLuma )
+    {
+        quality->verdict = MB_FRAME_QUALITY_VERDICT_OVEREXPOSED;
+    }
+    else if ( quality->glareFraction > settings->maxGlareFraction )
+    {
+        quality->verdict = MB_FRAME_QUALITY_VERDICT_GLARE;
+    }
+    else if ( quality->sharpness < settings->minSharpness )
+    {
+        quality->verdict = MB_FRAME_QUALITY_VERDICT_BLURRED;
+    }
+    else
+    {
+        quality->verdict = MB_FRAME_QUALITY_VERDICT_OK;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromVideoFrameWithQualityGate
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * frame,
+    MBFrameQualitySettings        const * settings,
+    MBUserDataRecognitionCallback const * callback,
+    MBFrameQuality                      * quality
+)
+{
+    MBFrameQuality frameQuality;
+
+    if ( frameQualityEvaluate( &frameQuality, frame, settings ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        /* quality cannot be measured, so leave the decision to the recognizer */
+        frameQuality.sharpness     = 0.f;
+        frameQuality.glareFraction = 0.f;
+        frameQuality.meanLuma      = 0;
+        frameQuality.verdict       = MB_FRAME_QUALITY_VERDICT_OK;
+    }
+
+    if ( quality != NULL )
+    {
+        *quality = frameQuality;
+    }
+
+    if ( frameQuality.verdict != MB_FRAME_QUALITY_VERDICT_OK )
+    {
+        return MB_RECOGNIZER_RESULT_STATE_EMPTY;
+    }
+
+    return recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, frame, MB_TRUE, callback );
+}
@@ -0,0 +1,167 @@
+/**
+ * @file FrameQuality.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef FRAME_QUALITY_H_
+#define FRAME_QUALITY_H_
+
+#include "UserDataRecognitionCallback.h"
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @enum MBFrameQualityVerdict
+ * @brief Outcome of the frame quality check, i.e. the reason why the frame was skipped.
+ */
+enum MBFrameQualityVerdict
+{
+    /** Frame is good enough to be recognized. */
+    MB_FRAME_QUALITY_VERDICT_OK = 0,
+
+    /** Frame is too dark. */
+    MB_FRAME_QUALITY_VERDICT_UNDEREXPOSED,
+
+    /** Frame is too bright. */
+    MB_FRAME_QUALITY_VERDICT_OVEREXPOSED,
+
+    /** Too large part of the frame is saturated, i.e. by reflection of a light source. */
+    MB_FRAME_QUALITY_VERDICT_GLARE,
+
+    /** Frame is out of focus, blurred by motion, or contains no edges at all. */
+    MB_FRAME_QUALITY_VERDICT_BLURRED,
+
+    /** Number of verdicts. */
+    MB_FRAME_QUALITY_VERDICT_COUNT
+};
+
+/**
+ * @brief Typedef for MBFrameQualityVerdict enum.
+ */
+typedef enum MBFrameQualityVerdict MBFrameQualityVerdict;
+
+/**
+ * @brief Returns null terminated name of the verdict, i.e. for logging why frames were skipped.
+ * @param verdict   Verdict of interest.
+ * @return name of the verdict.
+ */
+char const * frameQualityVerdictToString( MBFrameQualityVerdict verdict );
+
+/**
+ * @struct MBFrameQualitySettings
+ * @brief Thresholds of the frame quality check.
+ *
+ * Default values are conservative, so that only frames that are clearly unusable are skipped. They should be tuned on
+ * frames from the actual camera, i.e. by logging MBFrameQuality of frames which were and were not recognized.
+ */
+struct MBFrameQualitySettings
+{
+    /** Minimum sharpness, from 0 to 1. By default, this is set to 0.2. */
+    float minSharpness;
+
+    /** Maximum fraction of the frame that may be saturated, from 0 to 1. By default, this is set to 0.05. */
+    float maxGlareFraction;
+
+    /** Minimum average luma, from 0 to 255. By default, this is set to 40. */
+    int minMeanLuma;
+
+    /** Maximum average luma, from 0 to 255. By default, this is set to 225. */
+    int maxMeanLuma;
+};
+
+/**
+ * @brief Typedef for MBFrameQualitySettings structure.
+ */
+typedef struct MBFrameQualitySettings MBFrameQualitySettings;
+
+/**
+ * @memberof MBFrameQualitySettings
+ * @brief Populate MBFrameQualitySettings structure with default values.
+ * @param settings Settings that will be initialized.
+ */
+void frameQualitySettingsDefaultInit( MBFrameQualitySettings * settings );
+
+/**
+ * @struct MBFrameQuality
+ * @brief Measured quality of a single frame.
+ */
+struct MBFrameQuality
+{
+    /**
+     * Sharpness of edges in the frame, from 0 to 1. Sharp edges score above 0.3, while edges blurred over 4 or more
+     * pixels score close to 0. The score does not depend on contrast or exposure. Frame without edges scores 0.
+     */
+    float sharpness;
+
+    /** Fraction of the frame that is saturated, from 0 to 1. */
+    float glareFraction;
+
+    /** Average luma of the frame, from 0 to 255. */
+    int meanLuma;
+
+    /** Outcome of the check, the first failed check in order of declaration of MBFrameQualityVerdict. */
+    MBFrameQualityVerdict verdict;
+};
+
+/**
+ * @brief Typedef for MBFrameQuality structure.
+ */
+typedef struct MBFrameQuality MBFrameQuality;
+
+/**
+ * @brief Measures quality of the frame and checks it against the given thresholds.
+ *
+ * Exposure and glare are measured on a 32x24 luma thumbnail (@see ::recognizerImageSampleLuma), while sharpness is
+ * measured on a fixed grid of short pixel runs at full resolution, so the cost is a few tens of thousands of pixel reads
+ * regardless of the frame resolution, well under a millisecond. Frame orientation is ignored.
+ *
+ * @param quality   Structure that will receive the measurements.
+ * @param frame     Frame of interest.
+ * @param settings  Thresholds of the check, or NULL for default thresholds.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus frameQualityEvaluate( MBFrameQuality * quality, MBRecognizerImage const * frame, MBFrameQualitySettings const * settings );
+
+/**
+ * @brief Recognizes the video frame only if it passes the quality check.
+ *
+ * Skipped frames are not given to the recognizer runner at all, so they neither cost recognition time nor affect
+ * combining of consecutive video frames. If the quality cannot be measured, the frame is recognized.
+ *
+ * @param recognizerRunner  Recognizer runner that will perform recognition.
+ * @param frame             Video frame that will be recognized.
+ * @param settings          Thresholds of the check, or NULL for default thresholds.
+ * @param callback          Callbacks of the user, or NULL.
+ * @param quality           If not NULL, receives quality of the frame, including the reason why it was skipped.
+ * @return state of the recognition result, or MB_RECOGNIZER_RESULT_STATE_EMPTY if the frame was skipped.
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromVideoFrameWithQualityGate
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * frame,
+    MBFrameQualitySettings        const * settings,
+    MBUserDataRecognitionCallback const * callback,
+    MBFrameQuality                      * quality
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "ImageCorpus.h"
+#include "Platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <dirent.h>
+#   include <sys/stat.h>
+#endif
+
+#define MAX_PATH_LENGTH 1024
+
+static int isDirectory( char const * path )
+{
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA( path );
+    return attributes != INVALID_FILE_ATTRIBUTES && ( attributes & FILE_ATTRIBUTE_DIRECTORY ) != 0;
+#else
+    struct stat status;
+    return stat( path, &status ) == 0 && S_ISDIR( status.st_mode );
+#endif
+}
+
+static int hasImageExtension( char const * name )
+{
+    static char const * const extensions[] = { ".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff" };
+
+    char const * dot = strrchr( name, '.' );
+    size_t       i;
+
+    if ( dot == NULL )
+    {
+        return 0;
+    }
+
+    for ( i = 0; i < sizeof( extensions ) / sizeof( extensions[ 0 ] ); ++i )
+    {
+        char const * a = dot;
+        char const * b = extensions[ i ];
+
+        while ( *a != '\0' && *b != '\0' && ( *a | 0x20 ) == *b )
+        {
+            ++a;
+            ++b;
+        }
+        if ( *a == '\0' && *b == '\0' )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* joins folder and name into a newly allocated path, or returns a copy of name if folder is empty or name is absolute */
+static char * joinPath( char const * folder, size_t folderLength, char const * name, size_t nameLength )
+{
+    char * path;
+
+    if ( name[ 0 ] == '/' || name[ 0 ] == '\\' || ( nameLength > 1 && name[ 1 ] == ':' ) )
+    {
+        folderLength = 0;
+    }
+
+    path = ( char * ) malloc( folderLength + 1 + nameLength + 1 );
+    if ( path != NULL )
+    {
+        char * end = path;
+
+        if ( folderLength > 0 )
+        {
+            memcpy( end, folder, folderLength );
+            end[ folderLength ] = '/';
+            end += folderLength + 1;
+        }
+        memcpy( end, name, nameLength );
+        end[ nameLength ] = '\0';
+    }
+    return path;
+}
+
+/* adds path created by joinPath, whose last nameLength characters are the name of the image */
+static int addPath( MBImageCorpus * corpus, char * path, size_t nameLength )
+{
+    if ( path == NULL )
+    {
+        return 0;
+    }
+
+    if ( corpus->count == corpus->capacity )
+    {
+        size_t               capacity = corpus->capacity == 0 ? 64 : 2 * corpus->capacity;
+        MBImageCorpusEntry * entries  = ( MBImageCorpusEntry * ) realloc( corpus->entries, capacity * sizeof( MBImageCorpusEntry ) );
+
+        if ( entries == NULL )
+        {
+            free( path );
+            return 0;
+        }
+        corpus->entries  = entries;
+        corpus->capacity = capacity;
+    }
+
+    corpus->entries[ corpus->count ].path  = path;
+    corpus->entries[ corpus->count ].name  = path + strlen( path ) - nameLength;
+    corpus->entries[ corpus->count ].image = NULL;
+    ++corpus->count;
+    return 1;
+}
+
+static MBRecognizerErrorStatus listDirectory( MBImageCorpus * corpus, char const * folder )
+{
+    size_t folderLength = strlen( folder );
+#ifdef _WIN32
+    char             pattern[ MAX_PATH_LENGTH ];
+    WIN32_FIND_DATAA entry;
+    HANDLE           find;
+
+    if ( folderLength + 3 > sizeof( pattern ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+    memcpy( pattern, folder, folderLength );
+    memcpy( pattern + folderLength, "\\*", 3 );
+
+    find = FindFirstFileA( pattern, &entry );
+    if ( find == INVALID_HANDLE_VALUE )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+    do
+    {
+        size_t nameLength = strlen( entry.cFileName );
+
+        if ( ( entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0 && hasImageExtension( entry.cFileName ) &&
+             !addPath( corpus, joinPath( folder, folderLength, entry.cFileName, nameLength ), nameLength ) )
+        {
+            FindClose( find );
+            return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+        }
+    } while ( FindNextFileA( find, &entry ) );
+    FindClose( find );
+#else
+    DIR           * directory = opendir( folder );
+    struct dirent * entry;
+
+    if ( directory == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+    while ( ( entry = readdir( directory ) ) != NULL )
+    {
+        size_t nameLength = strlen( entry->d_name );
+
+        if ( entry->d_name[ 0 ] != '.' && hasImageExtension( entry->d_name ) &&
+             !addPath( corpus, joinPath( folder, folderLength, entry->d_name, nameLength ), nameLength ) )
+        {
+            closedir( directory );
+            return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+        }
+    }
+    closedir( directory );
+#endif
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static MBRecognizerErrorStatus readManifest( MBImageCorpus * corpus, char const * manifest )
+{
+    char         line[ MAX_PATH_LENGTH ];
+    char const * separator    = strrchr( manifest, '/' );
+    char const * bsSeparator  = strrchr( manifest, '\\' );
+    size_t       folderLength = 0;
+    FILE       * file         = platformOpenFile( manifest, "r" );
+
+    if ( file == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    if ( bsSeparator != NULL && ( separator == NULL || bsSeparator > separator ) )
+    {
+        separator = bsSeparator;
+    }
+    if ( separator != NULL )
+    {
+        folderLength = ( size_t ) ( separator - manifest );
+    }
+
+    while ( fgets( line, sizeof( line ), file ) != NULL )
+    {
+        char const * start  = line;
+        size_t       length = strlen( line );
+
+        while ( length > 0 && ( line[ length - 1 ] == '\n' || line[ length - 1 ] == '\r' || line[ length - 1 ] == ' ' || line[ length - 1 ] == '\t' ) )
+        {
+            --length;
+        }
+        while ( length > 0 && ( *start == ' ' || *start == '\t' ) )
+        {
+            ++start;
+            --length;
+        }
+        if ( length == 0 || start[ 0 ] == '#' )
+        {
+            continue;
+        }
+
+        if ( !addPath( corpus, joinPath( manifest, folderLength, start, length ), length ) )
+        {
+            fclose( file );
+            return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+        }
+    }
+
+    fclose( file );
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static int compareEntries( void const * a, void const * b )
+{
+    return strcmp( ( ( MBImageCorpusEntry const * ) a )->name, ( ( MBImageCorpusEntry const * ) b )->name );
+}
+
+MBRecognizerErrorStatus imageCorpusLoad( MBImageCorpus * corpus, char const * input, MBImageCorpusLoadFailed onLoadFailed, void * userData )
+{
+    MBRecognizerErrorStatus status;
+    size_t                  numLoaded = 0;
+    size_t                  i;
+
+    if ( corpus == NULL || input == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    status = isDirectory( input ) ? listDirectory( corpus, input ) : readManifest( corpus, input );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    if ( corpus->count > 0 )
+    {
+        qsort( corpus->entries, corpus->count, sizeof( MBImageCorpusEntry ), compareEntries );
+    }
+
+    for ( i = 0; i < corpus->count; ++i )
+    {
+        MBImageCorpusEntry entry = corpus->entries[ i ];
+
+        status = recognizerImageLoadFromFile( &entry.image, entry.path );
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+        {
+            if ( onLoadFailed != NULL )
+            {
+                onLoadFailed( entry.path, status, userData );
+            }
+            free( entry.path );
+            continue;
+        }
+        corpus->entries[ numLoaded++ ] = entry;
+    }
+    corpus->count = numLoaded;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+void imageCorpusFree( MBImageCorpus * corpus )
+{
+    size_t i;
+
+    if ( corpus == NULL )
+    {
+        return;
+    }
+
+    for ( i = 0; i < corpus->count; ++i )
+    {
+        recognizerImageDelete( &corpus->entries[ i ].image );
+        free( corpus->entries[ i ].path );
+    }
+    free( corpus->entries );
+    memset( corpus, 0, sizeof( MBImageCorpus ) );
+}
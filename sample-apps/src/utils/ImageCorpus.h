@@ -0,0 +1,111 @@
+/**
+ * @file ImageCorpus.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef IMAGE_CORPUS_H_
+#define IMAGE_CORPUS_H_
+
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBImageCorpusEntry
+ * @brief Single image of the corpus.
+ */
+struct MBImageCorpusEntry
+{
+    /** Path used to load the image. */
+    char              * path;
+
+    /**
+     * Name which identifies the image within the corpus, i.e. to match it with earlier measurements. It is the
+     * path as listed in the manifest, or the file name in the directory, and points into path.
+     */
+    char const        * name;
+
+    /** Decoded image. */
+    MBRecognizerImage * image;
+};
+
+/**
+ * @brief Typedef for MBImageCorpusEntry structure.
+ */
+typedef struct MBImageCorpusEntry MBImageCorpusEntry;
+
+/**
+ * @struct MBImageCorpus
+ * @brief Fixed set of images loaded into memory, i.e. to measure recognition without the cost of decoding image files.
+ */
+struct MBImageCorpus
+{
+    /** Images, in the order of their names. */
+    MBImageCorpusEntry * entries;
+
+    /** Number of images. */
+    size_t               count;
+
+    /** Number of allocated entries. */
+    size_t               capacity;
+};
+
+/**
+ * @brief Typedef for MBImageCorpus structure.
+ */
+typedef struct MBImageCorpus MBImageCorpus;
+
+/**
+ * @brief Function that is called for every image of the corpus that cannot be loaded.
+ *
+ * @param path      Path of the image.
+ * @param status    Status returned by ::recognizerImageLoadFromFile.
+ * @param userData  User data given to ::imageCorpusLoad.
+ */
+typedef void ( * MBImageCorpusLoadFailed )( char const * path, MBRecognizerErrorStatus status, void * userData );
+
+/**
+ * @brief Lists and decodes the images of a corpus.
+ *
+ * The input is either a directory, whose files with jpg, jpeg, png, bmp, tif and tiff extensions are loaded, or a
+ * manifest, i.e. a text file with a single path per line. Relative paths in the manifest are relative to its folder,
+ * and empty lines and lines starting with # are ignored. Images are sorted by their names, so that the corpus is the
+ * same on every run even though directory order is unspecified. Images that cannot be loaded are reported to
+ * onLoadFailed and skipped, so the corpus may end up empty.
+ *
+ * @param corpus        Corpus that will be filled, which must be zero initialized. Must be freed with ::imageCorpusFree
+ *                      regardless of the returned status.
+ * @param input         Path of the directory or the manifest.
+ * @param onLoadFailed  Function that will be called for images that cannot be loaded, or NULL.
+ * @param userData      User data passed to onLoadFailed.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_FAIL is returned if the directory or the manifest cannot
+ *         be read, and MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL if the list of images cannot be allocated.
+ */
+MBRecognizerErrorStatus imageCorpusLoad( MBImageCorpus * corpus, char const * input, MBImageCorpusLoadFailed onLoadFailed, void * userData );
+
+/**
+ * @brief Deletes the images of the corpus and zeroes it, so that it can be loaded again.
+ *
+ * @param corpus    Corpus to free.
+ */
+void imageCorpusFree( MBImageCorpus * corpus );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "LicenseUnlock.h"
+#include "Platform.h"
+
+#include <Recognizer/Licensing.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_RETRY_INTERVAL_MS 2000
+#define DEFAULT_GRACE_PERIOD_MS   60000
+
+/* arguments of any of the unlock functions */
+struct UnlockArguments
+{
+    char   const * licenseKey;
+    MBByte const * licenseBuffer;
+    size_t         licenseBufferLength;
+    char   const * licensee;
+};
+
+typedef struct UnlockArguments UnlockArguments;
+
+typedef MBRecognizerErrorStatus ( * UnlockFunction )( UnlockArguments const * arguments );
+
+/*
+ * unlockDone is published with release semantics after unlockStatus is written, so that a reader which observes it
+ * set also observes the status, without taking the mutex.
+ */
+static MBPlatformMutex          unlockMutex = MB_PLATFORM_MUTEX_INITIALIZER;
+static size_t volatile          unlockDone;
+static MBRecognizerErrorStatus  unlockStatus;
+
+static MBRecognizerErrorStatus unlockOnce( UnlockFunction unlock, UnlockArguments const * arguments )
+{
+    MBRecognizerErrorStatus status;
+
+    if ( platformAtomicLoadAcquire( &unlockDone ) )
+    {
+        return unlockStatus;
+    }
+
+    platformMutexLock( &unlockMutex );
+
+    /* another thread may have finished the unlock while this one was waiting */
+    if ( platformAtomicLoadAcquire( &unlockDone ) )
+    {
+        status = unlockStatus;
+    }
+    else
+    {
+        status = unlock( arguments );
+
+        /* network errors are transient, so the next call tries again */
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_NETWORK_ERROR )
+        {
+            unlockStatus = status;
+            platformAtomicStoreRelease( &unlockDone, 1 );
+        }
+    }
+
+    platformMutexUnlock( &unlockMutex );
+
+    return status;
+}
+
+static MBRecognizerErrorStatus unlockWithLicenseKey( UnlockArguments const * arguments )
+{
+    return recognizerAPIUnlockWithLicenseKey( arguments->licenseKey );
+}
+
+static MBRecognizerErrorStatus unlockWithLicenseBuffer( UnlockArguments const * arguments )
+{
+    return recognizerAPIUnlockWithLicenseBuffer( arguments->licenseBuffer, arguments->licenseBufferLength );
+}
+
+static MBRecognizerErrorStatus unlockForLicenseeWithLicenseKey( UnlockArguments const * arguments )
+{
+    return recognizerAPIUnlockForLicenseeWithLicenseKey( arguments->licenseKey, arguments->licensee );
+}
+
+static MBRecognizerErrorStatus unlockForLicenseeWithLicenseBuffer( UnlockArguments const * arguments )
+{
+    return recognizerAPIUnlockForLicenseeWithLicenseBuffer( arguments->licenseBuffer, arguments->licenseBufferLength, arguments->licensee );
+}
+
+MBRecognizerErrorStatus licenseUnlockWithLicenseKey( char const * licenseKeyBase64 )
+{
+    UnlockArguments arguments = { NULL, NULL, 0, NULL };
+
+    arguments.licenseKey = licenseKeyBase64;
+    return unlockOnce( unlockWithLicenseKey, &arguments );
+}
+
+MBRecognizerErrorStatus licenseUnlockWithLicenseBuffer( MBByte const * licenseBuffer, size_t licenseBufferLength )
+{
+    UnlockArguments arguments = { NULL, NULL, 0, NULL };
+
+    arguments.licenseBuffer       = licenseBuffer;
+    arguments.licenseBufferLength = licenseBufferLength;
+    return unlockOnce( unlockWithLicenseBuffer, &arguments );
+}
+
+MBRecognizerErrorStatus licenseUnlockForLicenseeWithLicenseKey( char const * licenseKeyBase64, char const * licensee )
+{
+    UnlockArguments arguments = { NULL, NULL, 0, NULL };
+
+    arguments.licenseKey = licenseKeyBase64;
+    arguments.licensee   = licensee;
+    return unlockOnce( unlockForLicenseeWithLicenseKey, &arguments );
+}
+
+MBRecognizerErrorStatus licenseUnlockForLicenseeWithLicenseBuffer( MBByte const * licenseBuffer, size_t licenseBufferLength, char const * licensee )
+{
+    UnlockArguments arguments = { NULL, NULL, 0, NULL };
+
+    arguments.licenseBuffer       = licenseBuffer;
+    arguments.licenseBufferLength = licenseBufferLength;
+    arguments.licensee            = licensee;
+    return unlockOnce( unlockForLicenseeWithLicenseBuffer, &arguments );
+}
+
+MBBool licenseUnlockIsUnlocked( void )
+{
+    return platformAtomicLoadAcquire( &unlockDone ) && unlockStatus == MB_RECOGNIZER_ERROR_STATUS_SUCCESS ? MB_TRUE : MB_FALSE;
+}
+
+void licenseUnlockBackgroundSettingsDefaultInit( MBLicenseUnlockBackgroundSettings * settings )
+{
+    settings->retryIntervalMs = DEFAULT_RETRY_INTERVAL_MS;
+    settings->gracePeriodMs   = DEFAULT_GRACE_PERIOD_MS;
+}
+
+/* state of the background unlock, guarded by backgroundMutex */
+static MBPlatformMutex                     backgroundMutex = MB_PLATFORM_MUTEX_INITIALIZER;
+static MBPlatformCondition                 backgroundChanged;
+static MBPlatformThread                    backgroundThread;
+static MBLicenseUnlockBackgroundSettings   backgroundSettings;
+static char                              * backgroundLicenseKey;
+static char                              * backgroundLicensee;
+static int                                 backgroundStarted;
+static int                                 backgroundFinished;
+static int                                 backgroundStopRequested;
+static int                                 backgroundJoined;
+static MBRecognizerErrorStatus             backgroundStatus;
+
+static char * copyString( char const * string )
+{
+    size_t size = strlen( string ) + 1;
+    char * copy = ( char * ) malloc( size );
+
+    if ( copy != NULL )
+    {
+        memcpy( copy, string, size );
+    }
+    return copy;
+}
+
+static void backgroundUnlock( void * argument )
+{
+    uint64_t start       = platformMonotonicNanoseconds();
+    uint64_t gracePeriod = ( uint64_t ) backgroundSettings.gracePeriodMs   * 1000000u;
+    uint64_t retryPeriod = ( uint64_t ) backgroundSettings.retryIntervalMs * 1000000u;
+
+    ( void ) argument;
+
+    for ( ;; )
+    {
+        MBRecognizerErrorStatus status;
+        uint64_t                now;
+        uint64_t                retryTime;
+
+        status = backgroundLicensee != NULL ?
+            licenseUnlockForLicenseeWithLicenseKey( backgroundLicenseKey, backgroundLicensee ) :
+            licenseUnlockWithLicenseKey( backgroundLicenseKey );
+
+        platformMutexLock( &backgroundMutex );
+
+        backgroundStatus = status;
+        now              = platformMonotonicNanoseconds();
+        if ( status != MB_RECOGNIZER_ERROR_STATUS_NETWORK_ERROR || backgroundStopRequested || now - start >= gracePeriod )
+        {
+            backgroundFinished = 1;
+            platformConditionBroadcast( &backgroundChanged );
+            platformMutexUnlock( &backgroundMutex );
+            return;
+        }
+        platformConditionBroadcast( &backgroundChanged );
+
+        /* sleep until the next attempt, unless stopped */
+        retryTime = now + retryPeriod;
+        while ( !backgroundStopRequested && now < retryTime )
+        {
+            platformConditionWait( &backgroundChanged, &backgroundMutex, retryTime - now );
+            now = platformMonotonicNanoseconds();
+        }
+
+        /* stop ends the retries immediately, without waiting for yet another attempt to reach the server */
+        if ( backgroundStopRequested )
+        {
+            backgroundFinished = 1;
+            platformConditionBroadcast( &backgroundChanged );
+            platformMutexUnlock( &backgroundMutex );
+            return;
+        }
+
+        platformMutexUnlock( &backgroundMutex );
+    }
+}
+
+MBRecognizerErrorStatus licenseUnlockStartBackground
+(
+    char                              const * licenseKeyBase64,
+    char                              const * licensee,
+    MBLicenseUnlockBackgroundSettings const * settings
+)
+{
+    MBRecognizerErrorStatus status = MB_RECOGNIZER_ERROR_STATUS_FAIL;
+
+    if ( licenseKeyBase64 == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    platformMutexLock( &backgroundMutex );
+
+    if ( !backgroundStarted )
+    {
+        if ( settings != NULL )
+        {
+            backgroundSettings = *settings;
+        }
+        else
+        {
+            licenseUnlockBackgroundSettingsDefaultInit( &backgroundSettings );
+        }
+
+        backgroundLicenseKey = copyString( licenseKeyBase64 );
+        backgroundLicensee   = licensee != NULL ? copyString( licensee ) : NULL;
+        backgroundStatus     = MB_RECOGNIZER_ERROR_STATUS_FAIL;
+
+        if ( backgroundLicenseKey != NULL && ( licensee == NULL || backgroundLicensee != NULL ) )
+        {
+            platformConditionInit( &backgroundChanged );
+            backgroundStarted = platformThreadCreate( &backgroundThread, backgroundUnlock, NULL );
+            if ( !backgroundStarted )
+            {
+                platformConditionDestroy( &backgroundChanged );
+            }
+        }
+
+        if ( backgroundStarted )
+        {
+            status = MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+        }
+        else
+        {
+            free( backgroundLicenseKey );
+            free( backgroundLicensee );
+            backgroundLicenseKey = NULL;
+            backgroundLicensee   = NULL;
+        }
+    }
+
+    platformMutexUnlock( &backgroundMutex );
+
+    return status;
+}
+
+MBRecognizerErrorStatus licenseUnlockWaitForBackground( uint32_t timeoutMs, MBBool * finished )
+{
+    MBRecognizerErrorStatus status;
+    uint64_t                now      = platformMonotonicNanoseconds();
+    uint64_t                deadline = now + ( uint64_t ) timeoutMs * 1000000u;
+
+    platformMutexLock( &backgroundMutex );
+
+    while ( backgroundStarted && !backgroundFinished && now < deadline )
+    {
+        platformConditionWait( &backgroundChanged, &backgroundMutex, deadline - now );
+        now = platformMonotonicNanoseconds();
+    }
+
+    status = backgroundStarted ? backgroundStatus : MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    if ( finished != NULL )
+    {
+        *finished = backgroundFinished ? MB_TRUE : MB_FALSE;
+    }
+
+    platformMutexUnlock( &backgroundMutex );
+
+    return status;
+}
+
+void licenseUnlockStopBackground( void )
+{
+    platformMutexLock( &backgroundMutex );
+
+    if ( !backgroundStarted || backgroundJoined )
+    {
+        platformMutexUnlock( &backgroundMutex );
+        return;
+    }
+
+    backgroundStopRequested = 1;
+    backgroundJoined        = 1;
+    platformConditionBroadcast( &backgroundChanged );
+
+    platformMutexUnlock( &backgroundMutex );
+
+    platformThreadJoin( &backgroundThread );
+
+    free( backgroundLicenseKey );
+    free( backgroundLicensee );
+    backgroundLicenseKey = NULL;
+    backgroundLicensee   = NULL;
+}
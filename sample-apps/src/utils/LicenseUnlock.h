@@ -0,0 +1,149 @@
+/**
+ * @file LicenseUnlock.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef LICENSE_UNLOCK_H_
+#define LICENSE_UNLOCK_H_
+
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Thread safe, idempotent counterparts of the unlock functions from Licensing.h.
+ *
+ * The first call performs the unlock while holding a lock, so concurrent callers wait for it instead of unlocking
+ * the SDK concurrently. Its status is then returned by all later calls without locking and without touching the SDK,
+ * regardless of the license key they pass. The only exception is MB_RECOGNIZER_ERROR_STATUS_NETWORK_ERROR, which is
+ * transient, so the next call tries to unlock again. All functions of this family share the same state, so the SDK
+ * is unlocked at most once per process, and the unlock functions from Licensing.h must not be called directly.
+ */
+
+/**
+ * @brief Thread safe, idempotent counterpart of ::recognizerAPIUnlockWithLicenseKey.
+ * @param licenseKeyBase64  License key, used only by the call that performs the unlock.
+ * @return status of the unlock.
+ */
+MBRecognizerErrorStatus licenseUnlockWithLicenseKey( char const * licenseKeyBase64 );
+
+/**
+ * @brief Thread safe, idempotent counterpart of ::recognizerAPIUnlockWithLicenseBuffer.
+ * @param licenseBuffer         License buffer, used only by the call that performs the unlock.
+ * @param licenseBufferLength   Length of the license buffer.
+ * @return status of the unlock.
+ */
+MBRecognizerErrorStatus licenseUnlockWithLicenseBuffer( MBByte const * licenseBuffer, size_t licenseBufferLength );
+
+/**
+ * @brief Thread safe, idempotent counterpart of ::recognizerAPIUnlockForLicenseeWithLicenseKey.
+ * @param licenseKeyBase64  License key, used only by the call that performs the unlock.
+ * @param licensee          Licensee, used only by the call that performs the unlock.
+ * @return status of the unlock.
+ */
+MBRecognizerErrorStatus licenseUnlockForLicenseeWithLicenseKey( char const * licenseKeyBase64, char const * licensee );
+
+/**
+ * @brief Thread safe, idempotent counterpart of ::recognizerAPIUnlockForLicenseeWithLicenseBuffer.
+ * @param licenseBuffer         License buffer, used only by the call that performs the unlock.
+ * @param licenseBufferLength   Length of the license buffer.
+ * @param licensee              Licensee, used only by the call that performs the unlock.
+ * @return status of the unlock.
+ */
+MBRecognizerErrorStatus licenseUnlockForLicenseeWithLicenseBuffer( MBByte const * licenseBuffer, size_t licenseBufferLength, char const * licensee );
+
+/**
+ * @brief Returns whether the SDK was successfully unlocked by one of the functions above.
+ * This is a single atomic read, so it may be called on every recognizer creation or frame.
+ * @return MB_TRUE if the SDK is unlocked.
+ */
+MBBool licenseUnlockIsUnlocked( void );
+
+/**
+ * @struct MBLicenseUnlockBackgroundSettings
+ * @brief Settings of ::licenseUnlockStartBackground.
+ */
+struct MBLicenseUnlockBackgroundSettings
+{
+    /** Time between attempts that failed with network error, in milliseconds. By default, this is set to 2000. */
+    uint32_t retryIntervalMs;
+
+    /**
+     * Time since the start of the background unlock during which network errors are retried, in milliseconds.
+     * After it expires, the unlock finishes with MB_RECOGNIZER_ERROR_STATUS_NETWORK_ERROR. By default, this is set
+     * to 60000.
+     */
+    uint32_t gracePeriodMs;
+};
+
+/**
+ * @brief Typedef for MBLicenseUnlockBackgroundSettings structure.
+ */
+typedef struct MBLicenseUnlockBackgroundSettings MBLicenseUnlockBackgroundSettings;
+
+/**
+ * @memberof MBLicenseUnlockBackgroundSettings
+ * @brief Populate MBLicenseUnlockBackgroundSettings structure with default values.
+ * @param settings Settings that will be initialized.
+ */
+void licenseUnlockBackgroundSettingsDefaultInit( MBLicenseUnlockBackgroundSettings * settings );
+
+/**
+ * @brief Unlocks the SDK on a background thread with ::licenseUnlockForLicenseeWithLicenseKey, or with
+ * ::licenseUnlockWithLicenseKey if licensee is NULL, so that licenses requiring online validation do not
+ * delay the start of the application. Network errors are retried until the grace period expires.
+ *
+ * Unlocking is not thread safe with respect to other SDK calls, so no function of the SDK, including loading images
+ * with it, may be called until ::licenseUnlockWaitForBackground reports that the background unlock finished.
+ * Meanwhile the application may only do work that does not involve the SDK, such as reading files, parsing
+ * configuration or preparing its UI. Background unlock can be started only once per process, and the SDK cache
+ * location must be set before it is started.
+ *
+ * @param licenseKeyBase64  License key, copied by the function.
+ * @param licensee          Licensee, copied by the function, or NULL.
+ * @param settings          Settings of the background unlock, or NULL for default settings.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_FAIL is returned if the background unlock was already
+ *         started or the thread could not be started.
+ */
+MBRecognizerErrorStatus licenseUnlockStartBackground
+(
+    char                              const * licenseKeyBase64,
+    char                              const * licensee,
+    MBLicenseUnlockBackgroundSettings const * settings
+);
+
+/**
+ * @brief Waits until the background unlock finishes or the timeout expires. SDK may be used only after this function
+ * reports that the background unlock finished.
+ * @param timeoutMs Maximum waiting time, in milliseconds. With 0, the status is only queried.
+ * @param finished  If not NULL, receives MB_TRUE if the background unlock finished, i.e. it will not be retried.
+ * @return status of the last attempt, or MB_RECOGNIZER_ERROR_STATUS_FAIL if no attempt finished yet.
+ */
+MBRecognizerErrorStatus licenseUnlockWaitForBackground( uint32_t timeoutMs, MBBool * finished );
+
+/**
+ * @brief Stops retrying and joins the background thread. Must be called before the application exits.
+ * An attempt that is in progress is not interrupted, so this may wait for its network round trip.
+ */
+void licenseUnlockStopBackground( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
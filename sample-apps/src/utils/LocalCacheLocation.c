@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "LocalCacheLocation.h"
+
+#include <Recognizer/RecognizerApiUtils.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   define PATH_SEPARATOR '\\'
+#else
+#   include <errno.h>
+#   include <stdio.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define PATH_SEPARATOR '/'
+
+/* machine-local folder that survives reboots, unlike /tmp, and is never part of a network-mounted home */
+#   define LOCAL_TEMPORARY_FOLDER "/var/tmp"
+#endif
+
+#define MAX_PATH_LENGTH 1024
+
+/* copies value of the environment variable into the buffer, returns 0 if it is not set or does not fit */
+static int readEnvironment( char * buffer, size_t bufferSize, char const * name )
+{
+#ifdef _WIN32
+    DWORD length = GetEnvironmentVariableA( name, buffer, ( DWORD ) bufferSize );
+    return length > 0 && length < bufferSize;
+#else
+    char const * value = getenv( name );
+    size_t       length;
+
+    if ( value == NULL || value[ 0 ] == '\0' )
+    {
+        return 0;
+    }
+
+    length = strlen( value );
+    if ( length >= bufferSize )
+    {
+        return 0;
+    }
+
+    memcpy( buffer, value, length + 1 );
+    return 1;
+#endif
+}
+
+static int append( char * buffer, size_t bufferSize, char const * component )
+{
+    size_t length          = strlen( buffer );
+    size_t componentLength = strlen( component );
+
+    if ( length + 1 + componentLength >= bufferSize )
+    {
+        return 0;
+    }
+
+    if ( length > 0 && buffer[ length - 1 ] != PATH_SEPARATOR && buffer[ length - 1 ] != '/' )
+    {
+        buffer[ length++ ] = PATH_SEPARATOR;
+    }
+    memcpy( buffer + length, component, componentLength + 1 );
+
+    return 1;
+}
+
+static int createFolder( char const * folder )
+{
+#ifdef _WIN32
+    return CreateDirectoryA( folder, NULL ) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+    return mkdir( folder, 0700 ) == 0 || errno == EEXIST;
+#endif
+}
+
+#ifndef _WIN32
+/*
+ * shared temporary folder is writable by everyone, so the folder must be a real directory owned by this user, which
+ * nobody else can access; folder that was ever accessible to others may already contain their files, so it is rejected
+ */
+static int isPrivateFolder( char const * folder )
+{
+    struct stat status;
+
+    return lstat( folder, &status ) == 0 && S_ISDIR( status.st_mode ) && status.st_uid == getuid() && ( status.st_mode & 077 ) == 0;
+}
+#endif
+
+/* per-user cache folder of the application, created if needed */
+static int applicationFolder( char * buffer, size_t bufferSize, char const * applicationName )
+{
+#ifdef _WIN32
+    return readEnvironment( buffer, bufferSize, "LOCALAPPDATA" ) && createFolder( buffer ) &&
+           append( buffer, bufferSize, applicationName ) && createFolder( buffer );
+#else
+    int length;
+
+    if ( readEnvironment( buffer, bufferSize, "XDG_CACHE_HOME" ) )
+    {
+        return createFolder( buffer ) && append( buffer, bufferSize, applicationName ) && createFolder( buffer );
+    }
+
+    /* home is deliberately avoided, because it is the folder that is mounted over network */
+    length = snprintf( buffer, bufferSize, "%s/%s-%lu", LOCAL_TEMPORARY_FOLDER, applicationName, ( unsigned long ) getuid() );
+    return length > 0 && ( size_t ) length < bufferSize && createFolder( buffer ) && isPrivateFolder( buffer );
+#endif
+}
+
+MBRecognizerErrorStatus localCacheLocationGet( char * folder, size_t folderSize, char const * applicationName )
+{
+    if ( folder == NULL || folderSize == 0 || applicationName == NULL || applicationName[ 0 ] == '\0' ||
+         strchr( applicationName, '/' ) != NULL || strchr( applicationName, '\\' ) != NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    folder[ 0 ] = '\0';
+
+    if ( !applicationFolder( folder, folderSize, applicationName ) )
+    {
+        folder[ 0 ] = '\0';
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus localCacheLocationApply( char const * applicationName )
+{
+    char                    folder[ MAX_PATH_LENGTH ];
+    MBRecognizerErrorStatus status = localCacheLocationGet( folder, sizeof( folder ), applicationName );
+
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    return recognizerAPISetCacheLocation( folder );
+}
@@ -0,0 +1,60 @@
+/**
+ * @file LocalCacheLocation.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef LOCAL_CACHE_LOCATION_H_
+#define LOCAL_CACHE_LOCATION_H_
+
+#include <Recognizer/RecognizerError.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Determines the per-user cache folder of the application on the local machine, and creates it if needed.
+ *
+ * The folder is %LOCALAPPDATA%\\applicationName on Windows, which is never part of the roaming profile. Elsewhere it
+ * is /var/tmp/applicationName-uid by default, instead of the usual $HOME/.cache, because the home folder is often
+ * mounted over network. Explicitly set XDG_CACHE_HOME overrides the default, and $XDG_CACHE_HOME/applicationName is
+ * used even if it is in the home folder. Folder in /var/tmp is created accessible only to its owner, and is rejected
+ * if it is owned by another user or accessible to anyone else.
+ *
+ * @param folder            Buffer that will receive null terminated path of the folder.
+ * @param folderSize        Size of the buffer, in bytes.
+ * @param applicationName   Name of the application folder, which must not contain path separators.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_FAIL is returned if the base folder is not defined
+ *         by the environment, or the folder cannot be created or is not private.
+ */
+MBRecognizerErrorStatus localCacheLocationGet( char * folder, size_t folderSize, char const * applicationName );
+
+/**
+ * @brief Makes the SDK store license counters and cached server permission in the local cache folder of the application
+ * (@see ::localCacheLocationGet), instead of the home folder.
+ *
+ * The SDK persists license counter state as scans are performed. When the home folder is mounted over network, every
+ * such write waits for the network and adds to the latency of recognition. Local cache folder keeps these writes on the
+ * local disk. Must be called before the SDK is unlocked.
+ *
+ * @param applicationName   Name of the application folder, which must not contain path separators.
+ * @return status of the operation. If it is not successful, cache location of the SDK is not changed.
+ */
+MBRecognizerErrorStatus localCacheLocationApply( char const * applicationName );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
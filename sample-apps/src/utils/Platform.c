@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#if !defined( _WIN32 ) && !defined( _POSIX_C_SOURCE )
+#   define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "Platform.h"
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <process.h>
+#   include <psapi.h>
+#   ifdef _MSC_VER
+#       pragma comment( lib, "psapi.lib" )
+#   endif
+#else
+#   include <sys/resource.h>
+#   include <time.h>
+#endif
+
+uint64_t platformMonotonicNanoseconds( void )
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER        counter;
+
+    if ( frequency.QuadPart == 0 )
+    {
+        QueryPerformanceFrequency( &frequency );
+    }
+    QueryPerformanceCounter( &counter );
+
+    /* split to avoid overflow of counter * 1e9 */
+    return ( uint64_t ) ( counter.QuadPart / frequency.QuadPart ) * 1000000000u +
+           ( uint64_t ) ( counter.QuadPart % frequency.QuadPart ) * 1000000000u / ( uint64_t ) frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( uint64_t ) now.tv_sec * 1000000000u + ( uint64_t ) now.tv_nsec;
+#endif
+}
+
+FILE * platformOpenFile( char const * path, char const * mode )
+{
+#ifdef _MSC_VER
+    FILE * file = NULL;
+    return fopen_s( &file, path, mode ) == 0 ? file : NULL;
+#else
+    return fopen( path, mode );
+#endif
+}
+
+FILE * platformOpenCommand( char const * command )
+{
+#ifdef _WIN32
+    return _popen( command, "r" );
+#else
+    return popen( command, "r" );
+#endif
+}
+
+int platformCloseCommand( FILE * output )
+{
+#ifdef _WIN32
+    return _pclose( output );
+#else
+    return pclose( output );
+#endif
+}
+
+uint64_t platformPeakRssBytes( void )
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        return ( uint64_t ) counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+        return 0;
+    }
+#   ifdef __APPLE__
+    return ( uint64_t ) usage.ru_maxrss;
+#   else
+    /* Linux reports kilobytes */
+    return ( uint64_t ) usage.ru_maxrss * 1024;
+#   endif
+#endif
+}
+
+void platformMutexInit( MBPlatformMutex * mutex )
+{
+#ifdef _WIN32
+    InitializeSRWLock( ( PSRWLOCK ) &mutex->lock );
+#else
+    pthread_mutex_init( &mutex->lock, NULL );
+#endif
+}
+
+void platformMutexDestroy( MBPlatformMutex * mutex )
+{
+#ifdef _WIN32
+    ( void ) mutex;
+#else
+    pthread_mutex_destroy( &mutex->lock );
+#endif
+}
+
+void platformMutexLock( MBPlatformMutex * mutex )
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive( ( PSRWLOCK ) &mutex->lock );
+#else
+    pthread_mutex_lock( &mutex->lock );
+#endif
+}
+
+void platformMutexUnlock( MBPlatformMutex * mutex )
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive( ( PSRWLOCK ) &mutex->lock );
+#else
+    pthread_mutex_unlock( &mutex->lock );
+#endif
+}
+
+void platformConditionInit( MBPlatformCondition * condition )
+{
+#ifdef _WIN32
+    InitializeConditionVariable( ( PCONDITION_VARIABLE ) &condition->condition );
+#elif defined( __APPLE__ )
+    pthread_cond_init( &condition->condition, NULL );
+#else
+    pthread_condattr_t attributes;
+
+    /* timeouts must not be affected by changes of the wall clock */
+    pthread_condattr_init( &attributes );
+    pthread_condattr_setclock( &attributes, CLOCK_MONOTONIC );
+    pthread_cond_init( &condition->condition, &attributes );
+    pthread_condattr_destroy( &attributes );
+#endif
+}
+
+void platformConditionDestroy( MBPlatformCondition * condition )
+{
+#ifdef _WIN32
+    ( void ) condition;
+#else
+    pthread_cond_destroy( &condition->condition );
+#endif
+}
+
+void platformConditionWait( MBPlatformCondition * condition, MBPlatformMutex * mutex, uint64_t timeoutNs )
+{
+#ifdef _WIN32
+    /* round up, so that short timeouts do not turn into busy waiting */
+    uint64_t timeoutMs = ( timeoutNs + 999999u ) / 1000000u;
+
+    SleepConditionVariableSRW( ( PCONDITION_VARIABLE ) &condition->condition, ( PSRWLOCK ) &mutex->lock, timeoutMs < INFINITE ? ( DWORD ) timeoutMs : INFINITE - 1, 0 );
+#elif defined( __APPLE__ )
+    struct timespec relative;
+
+    relative.tv_sec  = ( time_t ) ( timeoutNs / 1000000000u );
+    relative.tv_nsec = ( long ) ( timeoutNs % 1000000000u );
+    pthread_cond_timedwait_relative_np( &condition->condition, &mutex->lock, &relative );
+#else
+    struct timespec deadline;
+
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
+    deadline.tv_sec  += ( time_t ) ( timeoutNs / 1000000000u );
+    deadline.tv_nsec += ( long ) ( timeoutNs % 1000000000u );
+    if ( deadline.tv_nsec >= 1000000000L )
+    {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait( &condition->condition, &mutex->lock, &deadline );
+#endif
+}
+
+void platformConditionBroadcast( MBPlatformCondition * condition )
+{
+#ifdef _WIN32
+    WakeAllConditionVariable( ( PCONDITION_VARIABLE ) &condition->condition );
+#else
+    pthread_cond_broadcast( &condition->condition );
+#endif
+}
+
+#ifdef _WIN32
+static unsigned __stdcall threadMain( void * thread )
+#else
+static void * threadMain( void * thread )
+#endif
+{
+    ( ( MBPlatformThread * ) thread )->function( ( ( MBPlatformThread * ) thread )->argument );
+    return 0;
+}
+
+int platformThreadCreate( MBPlatformThread * thread, MBPlatformThreadFunction function, void * argument )
+{
+    thread->function = function;
+    thread->argument = argument;
+
+#ifdef _WIN32
+    /* unlike CreateThread, initializes the C runtime for the new thread */
+    thread->handle = ( void * ) _beginthreadex( NULL, 0, threadMain, thread, 0, NULL );
+    return thread->handle != NULL;
+#else
+    return pthread_create( &thread->handle, NULL, threadMain, thread ) == 0;
+#endif
+}
+
+void platformThreadJoin( MBPlatformThread * thread )
+{
+#ifdef _WIN32
+    WaitForSingleObject( ( HANDLE ) thread->handle, INFINITE );
+    CloseHandle( ( HANDLE ) thread->handle );
+    thread->handle = NULL;
+#else
+    pthread_join( thread->handle, NULL );
+#endif
+}
@@ -0,0 +1,233 @@
+/**
+ * @file Platform.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef SAMPLE_UTILS_PLATFORM_H_
+#define SAMPLE_UTILS_PLATFORM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined( _MSC_VER )
+#   include <intrin.h>
+#endif
+
+#if !defined( _WIN32 )
+#   include <pthread.h>
+#endif
+
+/** @brief Storage class specifier for variables that have separate instance in each thread. */
+#if defined( _MSC_VER )
+#   define MB_THREAD_LOCAL __declspec( thread )
+#elif defined( __STDC_VERSION__ ) && __STDC_VERSION__ >= 201112L
+#   define MB_THREAD_LOCAL _Thread_local
+#else
+#   define MB_THREAD_LOCAL __thread
+#endif
+
+/** @brief Inline function specifier that is accepted by all supported C compilers. */
+#if defined( _MSC_VER ) && !defined( __cplusplus )
+#   define MB_INLINE __inline
+#else
+#   define MB_INLINE inline
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Atomically reads the value with acquire semantics, i.e. memory operations that follow the read
+ * will observe all writes that preceded the matching ::platformAtomicStoreRelease in another thread.
+ */
+static MB_INLINE size_t platformAtomicLoadAcquire( size_t const volatile * value )
+{
+#if defined( _MSC_VER )
+    size_t result = *value;
+#   if defined( _M_ARM ) || defined( _M_ARM64 )
+    __dmb( _ARM64_BARRIER_ISH );
+#   endif
+    _ReadWriteBarrier();
+    return result;
+#else
+    return __atomic_load_n( value, __ATOMIC_ACQUIRE );
+#endif
+}
+
+/**
+ * @brief Atomically writes the value with release semantics, i.e. all memory operations that precede the write
+ * are visible to the thread that observes the written value with ::platformAtomicLoadAcquire.
+ */
+static MB_INLINE void platformAtomicStoreRelease( size_t volatile * destination, size_t value )
+{
+#if defined( _MSC_VER )
+    _ReadWriteBarrier();
+#   if defined( _M_ARM ) || defined( _M_ARM64 )
+    __dmb( _ARM64_BARRIER_ISH );
+#   endif
+    *destination = value;
+#else
+    __atomic_store_n( destination, value, __ATOMIC_RELEASE );
+#endif
+}
+
+/**
+ * @brief Returns the value of monotonic clock, in nanoseconds.
+ * Only differences between two values are meaningful, as clock starts from an unspecified point.
+ * @return current value of the monotonic clock
+ */
+uint64_t platformMonotonicNanoseconds( void );
+
+/**
+ * @brief Opens a file like fopen, using fopen_s where the C runtime deprecates fopen.
+ * @return opened file, or NULL on failure
+ */
+FILE * platformOpenFile( char const * path, char const * mode );
+
+/**
+ * @brief Runs the command with the shell of the system like popen, and opens its standard output for reading.
+ * @return standard output of the command, which must be closed with ::platformCloseCommand, or NULL on failure
+ */
+FILE * platformOpenCommand( char const * command );
+
+/**
+ * @brief Closes the output opened with ::platformOpenCommand and waits for the command to finish.
+ * @return exit status of the command, 0 on success
+ */
+int platformCloseCommand( FILE * output );
+
+/**
+ * @brief Returns the peak resident set size of the whole process so far, i.e. including the memory allocated by the SDK.
+ * @return peak resident set size in bytes, or 0 if it cannot be determined
+ */
+uint64_t platformPeakRssBytes( void );
+
+/**
+ * @struct MBPlatformMutex
+ * @brief Non-recursive mutual exclusion lock.
+ */
+struct MBPlatformMutex
+{
+#ifdef _WIN32
+    /* SRWLOCK, which has the size and alignment of a pointer */
+    void * lock;
+#else
+    pthread_mutex_t lock;
+#endif
+};
+
+/**
+ * @brief Typedef for MBPlatformMutex structure.
+ */
+typedef struct MBPlatformMutex MBPlatformMutex;
+
+/** @brief Static initializer of MBPlatformMutex, for mutexes that are never destroyed. */
+#ifdef _WIN32
+#   define MB_PLATFORM_MUTEX_INITIALIZER { NULL }
+#else
+#   define MB_PLATFORM_MUTEX_INITIALIZER { PTHREAD_MUTEX_INITIALIZER }
+#endif
+
+/**
+ * @struct MBPlatformCondition
+ * @brief Condition variable, used together with MBPlatformMutex.
+ */
+struct MBPlatformCondition
+{
+#ifdef _WIN32
+    /* CONDITION_VARIABLE, which has the size and alignment of a pointer */
+    void * condition;
+#else
+    pthread_cond_t condition;
+#endif
+};
+
+/**
+ * @brief Typedef for MBPlatformCondition structure.
+ */
+typedef struct MBPlatformCondition MBPlatformCondition;
+
+/** @brief Initializes the mutex. */
+void platformMutexInit( MBPlatformMutex * mutex );
+
+/** @brief Releases resources of the mutex, which must not be locked. */
+void platformMutexDestroy( MBPlatformMutex * mutex );
+
+/** @brief Locks the mutex, waiting while it is locked by another thread. */
+void platformMutexLock( MBPlatformMutex * mutex );
+
+/** @brief Unlocks the mutex locked by the calling thread. */
+void platformMutexUnlock( MBPlatformMutex * mutex );
+
+/** @brief Initializes the condition variable. */
+void platformConditionInit( MBPlatformCondition * condition );
+
+/** @brief Releases resources of the condition variable, which must not be waited on. */
+void platformConditionDestroy( MBPlatformCondition * condition );
+
+/**
+ * @brief Atomically unlocks the mutex and waits until the condition is signalled or until the timeout expires, then
+ * locks the mutex again. Wakeups may be spurious, so the caller must check its predicate after every wait.
+ * @param condition Condition variable to wait on.
+ * @param mutex     Mutex locked by the calling thread.
+ * @param timeoutNs Maximum waiting time, in nanoseconds.
+ */
+void platformConditionWait( MBPlatformCondition * condition, MBPlatformMutex * mutex, uint64_t timeoutNs );
+
+/** @brief Wakes all threads waiting on the condition variable. */
+void platformConditionBroadcast( MBPlatformCondition * condition );
+
+/**
+ * @brief Typedef for function executed by MBPlatformThread.
+ */
+typedef void ( * MBPlatformThreadFunction )( void * argument );
+
+/**
+ * @struct MBPlatformThread
+ * @brief Thread of execution, which must be joined with ::platformThreadJoin.
+ */
+struct MBPlatformThread
+{
+    MBPlatformThreadFunction function;
+    void                   * argument;
+#ifdef _WIN32
+    /* HANDLE */
+    void                   * handle;
+#else
+    pthread_t                handle;
+#endif
+};
+
+/**
+ * @brief Typedef for MBPlatformThread structure.
+ */
+typedef struct MBPlatformThread MBPlatformThread;
+
+/**
+ * @brief Starts a new thread executing the given function.
+ * @param thread    Thread structure, which must stay at the same address until the thread is joined.
+ * @param function  Function executed by the thread.
+ * @param argument  Argument given to the function.
+ * @return 1 if the thread was started, 0 otherwise.
+ */
+int platformThreadCreate( MBPlatformThread * thread, MBPlatformThreadFunction function, void * argument );
+
+/** @brief Waits until the thread started with ::platformThreadCreate finishes, and releases its resources. */
+void platformThreadJoin( MBPlatformThread * thread );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,597 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "QrCodeEncoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ECC_CODEWORDS_PER_BLOCK 30
+#define MAX_ALIGNMENT_PATTERNS      7
+
+/* number of error correction codewords in each block, indexed by error correction level and version */
+static signed char const eccCodewordsPerBlock[ 4 ][ MB_QR_CODE_MAX_VERSION + 1 ] =
+{
+    { -1,  7, 10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26, 30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 },
+    { -1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22, 24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28 },
+    { -1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24, 20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 },
+    { -1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22, 24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 }
+};
+
+/* number of error correction blocks, indexed by error correction level and version */
+static signed char const numErrorCorrectionBlocks[ 4 ][ MB_QR_CODE_MAX_VERSION + 1 ] =
+{
+    { -1, 1, 1, 1, 1, 1, 2, 2, 2, 2,  4,  4,  4,  4,  4,  6,  6,  6,  6,  7,  8,  8,  9,  9, 10, 12, 12, 12, 13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25 },
+    { -1, 1, 1, 1, 2, 2, 4, 4, 4, 5,  5,  5,  8,  9,  9, 10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25, 26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49 },
+    { -1, 1, 1, 2, 2, 4, 4, 6, 6, 8,  8,  8, 10, 12, 16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34, 35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68 },
+    { -1, 1, 1, 2, 4, 4, 4, 5, 6, 8,  8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81 }
+};
+
+/* two bit indicators of error correction levels in format information */
+static int const errorCorrectionFormatBits[ 4 ] = { 1, 0, 3, 2 };
+
+/* multiplication in GF(2^8) with the QR code polynomial x^8 + x^4 + x^3 + x^2 + 1 */
+static MBByte gfMultiply( MBByte a, MBByte b )
+{
+    unsigned result = 0;
+    int      i;
+
+    for ( i = 7; i >= 0; --i )
+    {
+        result = ( result << 1 ) ^ ( ( result >> 7 ) * 0x11D );
+        result ^= ( ( b >> i ) & 1u ) * a;
+    }
+
+    return ( MBByte ) result;
+}
+
+/* coefficients of the Reed-Solomon generator polynomial of given degree, without the leading 1 */
+static void reedSolomonDivisor( MBByte * divisor, int degree )
+{
+    MBByte root = 1;
+    int    i;
+    int    j;
+
+    memset( divisor, 0, ( size_t ) degree );
+    divisor[ degree - 1 ] = 1;
+
+    for ( i = 0; i < degree; ++i )
+    {
+        for ( j = 0; j < degree; ++j )
+        {
+            divisor[ j ] = gfMultiply( divisor[ j ], root );
+            if ( j + 1 < degree )
+            {
+                divisor[ j ] ^= divisor[ j + 1 ];
+            }
+        }
+        root = gfMultiply( root, 0x02 );
+    }
+}
+
+static void reedSolomonRemainder( MBByte * remainder, MBByte const * data, int dataLength, MBByte const * divisor, int degree )
+{
+    int i;
+    int j;
+
+    memset( remainder, 0, ( size_t ) degree );
+
+    for ( i = 0; i < dataLength; ++i )
+    {
+        MBByte factor = ( MBByte ) ( data[ i ] ^ remainder[ 0 ] );
+
+        memmove( remainder, remainder + 1, ( size_t ) ( degree - 1 ) );
+        remainder[ degree - 1 ] = 0;
+        for ( j = 0; j < degree; ++j )
+        {
+            remainder[ j ] ^= gfMultiply( divisor[ j ], factor );
+        }
+    }
+}
+
+/* number of modules available for data and error correction, i.e. not occupied by function patterns */
+static int numRawDataModules( int version )
+{
+    int result = ( 16 * version + 128 ) * version + 64;
+
+    if ( version >= 2 )
+    {
+        int numAlignment = version / 7 + 2;
+
+        result -= ( 25 * numAlignment - 10 ) * numAlignment - 55;
+        if ( version >= 7 )
+        {
+            result -= 36;
+        }
+    }
+
+    return result;
+}
+
+static int numDataCodewords( int version, MBQrCodeErrorCorrection errorCorrection )
+{
+    return numRawDataModules( version ) / 8 - eccCodewordsPerBlock[ errorCorrection ][ version ] * numErrorCorrectionBlocks[ errorCorrection ][ version ];
+}
+
+/* centers of alignment patterns, which are the same for rows and columns */
+static int alignmentPositions( int positions[ MAX_ALIGNMENT_PATTERNS ], int version )
+{
+    int numAlignment;
+    int step;
+    int position;
+    int i;
+
+    if ( version == 1 )
+    {
+        return 0;
+    }
+
+    numAlignment = version / 7 + 2;
+    step         = ( version * 8 + numAlignment * 3 + 5 ) / ( numAlignment * 4 - 4 ) * 2;
+    position     = version * 4 + 10;
+
+    positions[ 0 ] = 6;
+    for ( i = numAlignment - 1; i >= 1; --i, position -= step )
+    {
+        positions[ i ] = position;
+    }
+
+    return numAlignment;
+}
+
+static void setFunctionModule( MBQrCode * code, MBByte * isFunction, int x, int y, int dark )
+{
+    code->modules[ y * code->size + x ] = ( MBByte ) ( dark ? 1 : 0 );
+    isFunction   [ y * code->size + x ] = 1;
+}
+
+static void drawFinderPattern( MBQrCode * code, MBByte * isFunction, int centerX, int centerY )
+{
+    int dx;
+    int dy;
+
+    /* 7x7 pattern with one module of separator around it */
+    for ( dy = -4; dy <= 4; ++dy )
+    {
+        for ( dx = -4; dx <= 4; ++dx )
+        {
+            int x        = centerX + dx;
+            int y        = centerY + dy;
+            int distance = abs( dx ) > abs( dy ) ? abs( dx ) : abs( dy );
+
+            if ( x >= 0 && x < code->size && y >= 0 && y < code->size )
+            {
+                setFunctionModule( code, isFunction, x, y, distance != 2 && distance != 4 );
+            }
+        }
+    }
+}
+
+static void drawAlignmentPattern( MBQrCode * code, MBByte * isFunction, int centerX, int centerY )
+{
+    int dx;
+    int dy;
+
+    for ( dy = -2; dy <= 2; ++dy )
+    {
+        for ( dx = -2; dx <= 2; ++dx )
+        {
+            int distance = abs( dx ) > abs( dy ) ? abs( dx ) : abs( dy );
+            setFunctionModule( code, isFunction, centerX + dx, centerY + dy, distance != 1 );
+        }
+    }
+}
+
+static void drawFormatBits( MBQrCode * code, MBByte * isFunction, int mask )
+{
+    int data      = errorCorrectionFormatBits[ code->errorCorrection ] << 3 | mask;
+    int remainder = data;
+    int bits;
+    int i;
+
+    for ( i = 0; i < 10; ++i )
+    {
+        remainder = ( remainder << 1 ) ^ ( ( remainder >> 9 ) * 0x537 );
+    }
+    bits = ( data << 10 | remainder ) ^ 0x5412;
+
+    /* first copy, around the top left finder pattern */
+    for ( i = 0; i <= 5; ++i )
+    {
+        setFunctionModule( code, isFunction, 8, i, ( bits >> i ) & 1 );
+    }
+    setFunctionModule( code, isFunction, 8, 7, ( bits >> 6 ) & 1 );
+    setFunctionModule( code, isFunction, 8, 8, ( bits >> 7 ) & 1 );
+    setFunctionModule( code, isFunction, 7, 8, ( bits >> 8 ) & 1 );
+    for ( i = 9; i < 15; ++i )
+    {
+        setFunctionModule( code, isFunction, 14 - i, 8, ( bits >> i ) & 1 );
+    }
+
+    /* second copy, split between the other two finder patterns */
+    for ( i = 0; i < 8; ++i )
+    {
+        setFunctionModule( code, isFunction, code->size - 1 - i, 8, ( bits >> i ) & 1 );
+    }
+    for ( i = 8; i < 15; ++i )
+    {
+        setFunctionModule( code, isFunction, 8, code->size - 15 + i, ( bits >> i ) & 1 );
+    }
+    setFunctionModule( code, isFunction, 8, code->size - 8, 1 );
+}
+
+static void drawVersionBits( MBQrCode * code, MBByte * isFunction )
+{
+    long remainder = code->version;
+    long bits;
+    int  i;
+
+    if ( code->version < 7 )
+    {
+        return;
+    }
+
+    for ( i = 0; i < 12; ++i )
+    {
+        remainder = ( remainder << 1 ) ^ ( ( remainder >> 11 ) * 0x1F25 );
+    }
+    bits = ( long ) code->version << 12 | remainder;
+
+    for ( i = 0; i < 18; ++i )
+    {
+        int dark = ( int ) ( ( bits >> i ) & 1 );
+        int a    = code->size - 11 + i % 3;
+        int b    = i / 3;
+
+        setFunctionModule( code, isFunction, a, b, dark );
+        setFunctionModule( code, isFunction, b, a, dark );
+    }
+}
+
+static void drawFunctionPatterns( MBQrCode * code, MBByte * isFunction )
+{
+    int positions[ MAX_ALIGNMENT_PATTERNS ];
+    int numAlignment = alignmentPositions( positions, code->version );
+    int i;
+    int j;
+
+    for ( i = 0; i < code->size; ++i )
+    {
+        setFunctionModule( code, isFunction, 6, i, i % 2 == 0 );
+        setFunctionModule( code, isFunction, i, 6, i % 2 == 0 );
+    }
+
+    drawFinderPattern( code, isFunction, 3, 3 );
+    drawFinderPattern( code, isFunction, code->size - 4, 3 );
+    drawFinderPattern( code, isFunction, 3, code->size - 4 );
+
+    for ( i = 0; i < numAlignment; ++i )
+    {
+        for ( j = 0; j < numAlignment; ++j )
+        {
+            /* alignment patterns are not drawn over the three finder patterns */
+            if ( !( i == 0 && j == 0 ) && !( i == 0 && j == numAlignment - 1 ) && !( i == numAlignment - 1 && j == 0 ) )
+            {
+                drawAlignmentPattern( code, isFunction, positions[ i ], positions[ j ] );
+            }
+        }
+    }
+
+    /* reserves the format area, which is redrawn once the mask is known */
+    drawFormatBits( code, isFunction, 0 );
+    drawVersionBits( code, isFunction );
+}
+
+/* places codewords in two-module wide columns, zig-zagging from the bottom right corner */
+static void drawCodewords( MBQrCode * code, MBByte const * isFunction, MBByte const * codewords, int numCodewords )
+{
+    long numBits = ( long ) numCodewords * 8;
+    long bit     = 0;
+    int  right;
+    int  vertical;
+    int  j;
+
+    for ( right = code->size - 1; right >= 1; right -= 2 )
+    {
+        if ( right == 6 )
+        {
+            /* skips the vertical timing pattern */
+            right = 5;
+        }
+        for ( vertical = 0; vertical < code->size; ++vertical )
+        {
+            for ( j = 0; j < 2; ++j )
+            {
+                int x       = right - j;
+                int upwards = ( ( right + 1 ) & 2 ) == 0;
+                int y       = upwards ? code->size - 1 - vertical : vertical;
+
+                if ( !isFunction[ y * code->size + x ] && bit < numBits )
+                {
+                    code->modules[ y * code->size + x ] = ( MBByte ) ( ( codewords[ bit >> 3 ] >> ( 7 - ( bit & 7 ) ) ) & 1 );
+                    ++bit;
+                }
+            }
+        }
+    }
+}
+
+static int maskBit( int mask, int x, int y )
+{
+    switch ( mask )
+    {
+        case 0:  return ( x + y ) % 2 == 0;
+        case 1:  return y % 2 == 0;
+        case 2:  return x % 3 == 0;
+        case 3:  return ( x + y ) % 3 == 0;
+        case 4:  return ( x / 3 + y / 2 ) % 2 == 0;
+        case 5:  return x * y % 2 + x * y % 3 == 0;
+        case 6:  return ( x * y % 2 + x * y % 3 ) % 2 == 0;
+        default: return ( ( x + y ) % 2 + x * y % 3 ) % 2 == 0;
+    }
+}
+
+/* applying the same mask twice removes it */
+static void applyMask( MBQrCode * code, MBByte const * isFunction, int mask )
+{
+    int x;
+    int y;
+
+    for ( y = 0; y < code->size; ++y )
+    {
+        for ( x = 0; x < code->size; ++x )
+        {
+            if ( !isFunction[ y * code->size + x ] && maskBit( mask, x, y ) )
+            {
+                code->modules[ y * code->size + x ] ^= 1;
+            }
+        }
+    }
+}
+
+/* penalty of runs and finder-like patterns along a single row or column */
+static long linePenalty( MBQrCode const * code, int start, int step )
+{
+    static MBByte const finderLike[ 2 ][ 11 ] =
+    {
+        { 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1 }
+    };
+
+    MBByte const * line    = code->modules + start;
+    long           penalty = 0;
+    int            run     = 1;
+    int            i;
+    int            p;
+
+    for ( i = 1; i <= code->size; ++i )
+    {
+        if ( i < code->size && line[ i * step ] == line[ ( i - 1 ) * step ] )
+        {
+            ++run;
+            continue;
+        }
+        if ( run >= 5 )
+        {
+            penalty += 3 + ( run - 5 );
+        }
+        run = 1;
+    }
+
+    for ( i = 0; i + 11 <= code->size; ++i )
+    {
+        for ( p = 0; p < 2; ++p )
+        {
+            int k = 0;
+
+            while ( k < 11 && line[ ( i + k ) * step ] == finderLike[ p ][ k ] )
+            {
+                ++k;
+            }
+            if ( k == 11 )
+            {
+                penalty += 40;
+            }
+        }
+    }
+
+    return penalty;
+}
+
+static long maskPenalty( MBQrCode const * code )
+{
+    int  size    = code->size;
+    long penalty = 0;
+    long dark    = 0;
+    long deviation;
+    int  x;
+    int  y;
+
+    for ( y = 0; y < size; ++y )
+    {
+        penalty += linePenalty( code, y * size, 1 );
+        penalty += linePenalty( code, y, size );
+    }
+
+    for ( y = 0; y < size; ++y )
+    {
+        for ( x = 0; x < size; ++x )
+        {
+            MBByte module = code->modules[ y * size + x ];
+
+            dark += module;
+            if ( x + 1 < size && y + 1 < size && module == code->modules[ y * size + x + 1 ] &&
+                 module == code->modules[ ( y + 1 ) * size + x ] && module == code->modules[ ( y + 1 ) * size + x + 1 ] )
+            {
+                penalty += 3;
+            }
+        }
+    }
+
+    /* 10 points for every 5% of deviation from equal number of dark and light modules */
+    deviation = labs( dark * 100 / ( ( long ) size * size ) - 50 );
+    penalty  += deviation / 5 * 10;
+
+    return penalty;
+}
+
+static void appendBits( MBByte * buffer, long * bitLength, unsigned long value, int numBits )
+{
+    int i;
+
+    for ( i = numBits - 1; i >= 0; --i, ++*bitLength )
+    {
+        if ( ( value >> i ) & 1u )
+        {
+            buffer[ *bitLength >> 3 ] |= ( MBByte ) ( 0x80 >> ( *bitLength & 7 ) );
+        }
+    }
+}
+
+MBRecognizerErrorStatus qrCodeEncodeBytes( MBQrCode * code, MBByte const * data, size_t dataLength, MBQrCodeErrorCorrection errorCorrection, int minimumVersion )
+{
+    MBByte   divisor[ MAX_ECC_CODEWORDS_PER_BLOCK ];
+    MBByte * scratch;
+    MBByte * isFunction;
+    MBByte * dataCodewords;
+    MBByte * eccCodewords;
+    MBByte * codewords;
+    long     bitLength = 0;
+    long     bestPenalty = -1;
+    int      version;
+    int      capacity;
+    int      numBlocks;
+    int      blockEccLength;
+    int      numRawCodewords;
+    int      numShortBlocks;
+    int      shortBlockLength;
+    int      numCodewords = 0;
+    int      offset;
+    int      mask = 0;
+    int      i;
+    int      j;
+    size_t   k;
+
+    if ( code == NULL || ( data == NULL && dataLength > 0 ) || errorCorrection < MB_QR_CODE_ERROR_CORRECTION_L ||
+         errorCorrection > MB_QR_CODE_ERROR_CORRECTION_H || minimumVersion < 1 || minimumVersion > MB_QR_CODE_MAX_VERSION )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* mode indicator, character count and data must fit */
+    for ( version = minimumVersion; version <= MB_QR_CODE_MAX_VERSION; ++version )
+    {
+        int countBits = version <= 9 ? 8 : 16;
+
+        capacity = numDataCodewords( version, errorCorrection );
+        if ( dataLength < ( ( size_t ) 1 << countBits ) && 4 + countBits + 8 * ( long ) dataLength <= capacity * 8L )
+        {
+            break;
+        }
+    }
+    if ( version > MB_QR_CODE_MAX_VERSION )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    code->version         = version;
+    code->size            = version * 4 + 17;
+    code->errorCorrection = errorCorrection;
+
+    numBlocks        = numErrorCorrectionBlocks[ errorCorrection ][ version ];
+    blockEccLength   = eccCodewordsPerBlock[ errorCorrection ][ version ];
+    numRawCodewords  = numRawDataModules( version ) / 8;
+    numShortBlocks   = numBlocks - numRawCodewords % numBlocks;
+    shortBlockLength = numRawCodewords / numBlocks;
+
+    scratch = ( MBByte * ) calloc( ( size_t ) ( code->size * code->size + capacity + numBlocks * blockEccLength + numRawCodewords ), 1 );
+    if ( scratch == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+    isFunction    = scratch;
+    dataCodewords = isFunction + code->size * code->size;
+    eccCodewords  = dataCodewords + capacity;
+    codewords     = eccCodewords + numBlocks * blockEccLength;
+
+    /* byte mode segment, terminator and padding */
+    appendBits( dataCodewords, &bitLength, 0x4, 4 );
+    appendBits( dataCodewords, &bitLength, ( unsigned long ) dataLength, version <= 9 ? 8 : 16 );
+    for ( k = 0; k < dataLength; ++k )
+    {
+        appendBits( dataCodewords, &bitLength, data[ k ], 8 );
+    }
+    bitLength += capacity * 8L - bitLength < 4 ? capacity * 8L - bitLength : 4;
+    bitLength  = ( bitLength + 7 ) / 8 * 8;
+    for ( i = ( int ) ( bitLength / 8 ); i < capacity; ++i )
+    {
+        dataCodewords[ i ] = ( MBByte ) ( ( i - bitLength / 8 ) % 2 == 0 ? 0xEC : 0x11 );
+    }
+
+    /* error correction of each block; long blocks have one data codeword more than short ones */
+    reedSolomonDivisor( divisor, blockEccLength );
+    for ( i = 0, offset = 0; i < numBlocks; ++i )
+    {
+        int blockDataLength = shortBlockLength - blockEccLength + ( i < numShortBlocks ? 0 : 1 );
+
+        reedSolomonRemainder( eccCodewords + i * blockEccLength, dataCodewords + offset, blockDataLength, divisor, blockEccLength );
+        offset += blockDataLength;
+    }
+
+    /* interleaving: i-th data codewords of all blocks, then i-th error correction codewords of all blocks */
+    for ( i = 0; i <= shortBlockLength - blockEccLength; ++i )
+    {
+        for ( j = 0, offset = 0; j < numBlocks; ++j )
+        {
+            int blockDataLength = shortBlockLength - blockEccLength + ( j < numShortBlocks ? 0 : 1 );
+
+            if ( i < blockDataLength )
+            {
+                codewords[ numCodewords++ ] = dataCodewords[ offset + i ];
+            }
+            offset += blockDataLength;
+        }
+    }
+    for ( i = 0; i < blockEccLength; ++i )
+    {
+        for ( j = 0; j < numBlocks; ++j )
+        {
+            codewords[ numCodewords++ ] = eccCodewords[ j * blockEccLength + i ];
+        }
+    }
+
+    memset( code->modules, 0, ( size_t ) ( code->size * code->size ) );
+    drawFunctionPatterns( code, isFunction );
+    drawCodewords( code, isFunction, codewords, numCodewords );
+
+    for ( i = 0; i < 8; ++i )
+    {
+        long penalty;
+
+        applyMask( code, isFunction, i );
+        drawFormatBits( code, isFunction, i );
+        penalty = maskPenalty( code );
+        if ( bestPenalty < 0 || penalty < bestPenalty )
+        {
+            bestPenalty = penalty;
+            mask        = i;
+        }
+        applyMask( code, isFunction, i );
+    }
+
+    applyMask( code, isFunction, mask );
+    drawFormatBits( code, isFunction, mask );
+    code->mask = mask;
+
+    free( scratch );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file QrCodeEncoder.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef QR_CODE_ENCODER_H_
+#define QR_CODE_ENCODER_H_
+
+#include "Platform.h"
+
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Largest QR code version. */
+#define MB_QR_CODE_MAX_VERSION 40
+
+/** @brief Number of modules on each side of the largest QR code, without quiet zone. */
+#define MB_QR_CODE_MAX_SIZE ( 4 * MB_QR_CODE_MAX_VERSION + 17 )
+
+/**
+ * @brief Error correction level of QR code, with approximate share of codewords that can be restored.
+ */
+enum MBQrCodeErrorCorrection
+{
+    /** 7% */
+    MB_QR_CODE_ERROR_CORRECTION_L = 0,
+
+    /** 15% */
+    MB_QR_CODE_ERROR_CORRECTION_M,
+
+    /** 25% */
+    MB_QR_CODE_ERROR_CORRECTION_Q,
+
+    /** 30% */
+    MB_QR_CODE_ERROR_CORRECTION_H
+};
+
+/**
+ * @brief Typedef for MBQrCodeErrorCorrection enum.
+ */
+typedef enum MBQrCodeErrorCorrection MBQrCodeErrorCorrection;
+
+/**
+ * @struct MBQrCode
+ * @brief Modules of an encoded QR code (ISO/IEC 18004).
+ */
+struct MBQrCode
+{
+    /** Version of the symbol, from 1 to MB_QR_CODE_MAX_VERSION. */
+    int version;
+
+    /** Number of modules on each side of the symbol, without quiet zone. */
+    int size;
+
+    /** Error correction level of the symbol. */
+    MBQrCodeErrorCorrection errorCorrection;
+
+    /** Data mask applied to the symbol, from 0 to 7. */
+    int mask;
+
+    /** size x size modules in row-major order, 1 for dark and 0 for light modules. */
+    MBByte modules[ MB_QR_CODE_MAX_SIZE * MB_QR_CODE_MAX_SIZE ];
+};
+
+/**
+ * @brief Typedef for MBQrCode structure.
+ */
+typedef struct MBQrCode MBQrCode;
+
+/**
+ * @brief Encodes binary data into the smallest QR code of the given error correction level, using byte mode.
+ *
+ * Byte mode stores the data as is, so HUB3 payloads are encoded in the character set in which they are given.
+ * The mask is chosen by the penalty rules of the standard.
+ *
+ * @param code              Structure that receives the encoded symbol. It is large, so it should not be on the stack.
+ * @param data              Data to encode.
+ * @param dataLength        Length of data, in bytes.
+ * @param errorCorrection   Error correction level.
+ * @param minimumVersion    Smallest version that may be used, i.e. to make symbols of a corpus the same size, or 1.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if the data does not fit
+ *         into the largest symbol.
+ */
+MBRecognizerErrorStatus qrCodeEncodeBytes( MBQrCode * code, MBByte const * data, size_t dataLength, MBQrCodeErrorCorrection errorCorrection, int minimumVersion );
+
+/**
+ * @memberof MBQrCode
+ * @brief Returns whether the module at the given position is dark.
+ * @param code  Encoded symbol.
+ * @param x     Column of the module, from 0 to size - 1.
+ * @param y     Row of the module, from 0 to size - 1.
+ * @return MB_TRUE for dark module.
+ */
+static MB_INLINE MBBool qrCodeModule( MBQrCode const * code, int x, int y )
+{
+    return code->modules[ y * code->size + x ] ? MB_TRUE : MB_FALSE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "RecognitionEventRing.h"
+#include "Platform.h"
+#include "UserDataRecognitionCallback.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE_SIZE 64
+
+struct MBRecognitionEventRing
+{
+    MBRecognitionEvent * events;
+    size_t               mask;
+
+    /* producer and consumer indices live on separate cache lines to avoid false sharing */
+    char                 padding0[ CACHE_LINE_SIZE ];
+    size_t volatile      head;    /* next event to consume, written by consumer */
+    char                 padding1[ CACHE_LINE_SIZE - sizeof( size_t ) ];
+    size_t volatile      tail;    /* next free slot, written by producer */
+    size_t volatile      dropped; /* written by producer */
+    char                 padding2[ CACHE_LINE_SIZE - 2 * sizeof( size_t ) ];
+};
+
+typedef struct RingProducer
+{
+    MBRecognitionEventRing * ring;
+    uint64_t                 tag;
+} RingProducer;
+
+MBRecognizerErrorStatus recognitionEventRingCreate( MBRecognitionEventRing ** ring, size_t capacity )
+{
+    size_t roundedCapacity = 1;
+
+    if ( ring == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *ring = NULL;
+
+    if ( capacity == 0 || capacity > ( ( size_t ) -1 >> 1 ) / sizeof( MBRecognitionEvent ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    while ( roundedCapacity < capacity )
+    {
+        roundedCapacity <<= 1;
+    }
+
+    *ring = ( MBRecognitionEventRing * ) calloc( 1, sizeof( MBRecognitionEventRing ) );
+    if ( *ring == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    ( *ring )->events = ( MBRecognitionEvent * ) malloc( roundedCapacity * sizeof( MBRecognitionEvent ) );
+    if ( ( *ring )->events == NULL )
+    {
+        free( *ring );
+        *ring = NULL;
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    ( *ring )->mask = roundedCapacity - 1;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognitionEventRingDelete( MBRecognitionEventRing ** ring )
+{
+    if ( ring == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *ring != NULL )
+    {
+        free( ( *ring )->events );
+        free( *ring );
+        *ring = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+size_t recognitionEventRingPop( MBRecognitionEventRing * ring, MBRecognitionEvent * events, size_t maxEvents )
+{
+    size_t head      = ring->head;
+    size_t available = platformAtomicLoadAcquire( &ring->tail ) - head;
+    size_t count     = available < maxEvents ? available : maxEvents;
+    size_t i;
+
+    for ( i = 0; i < count; ++i )
+    {
+        events[ i ] = ring->events[ ( head + i ) & ring->mask ];
+    }
+
+    platformAtomicStoreRelease( &ring->head, head + count );
+
+    return count;
+}
+
+size_t recognitionEventRingDroppedCount( MBRecognitionEventRing const * ring )
+{
+    return platformAtomicLoadAcquire( &ring->dropped );
+}
+
+/* returns slot for the next event, or NULL if ring is full */
+static MBRecognitionEvent * beginPush( RingProducer * producer, MBRecognitionEventType type )
+{
+    MBRecognitionEventRing * ring = producer->ring;
+    size_t                   tail = ring->tail;
+    MBRecognitionEvent     * event;
+
+    if ( tail - platformAtomicLoadAcquire( &ring->head ) > ring->mask )
+    {
+        platformAtomicStoreRelease( &ring->dropped, ring->dropped + 1 );
+        return NULL;
+    }
+
+    event                  = &ring->events[ tail & ring->mask ];
+    event->tag             = producer->tag;
+    event->timestampNs     = platformMonotonicNanoseconds();
+    event->type            = type;
+    event->detectionStatus = DETECTION_STATUS_FAIL;
+    event->hasGlare        = MB_FALSE;
+    event->pointsSize      = 0;
+
+    return event;
+}
+
+static void endPush( RingProducer * producer )
+{
+    platformAtomicStoreRelease( &producer->ring->tail, producer->ring->tail + 1 );
+}
+
+static void pushSimpleEvent( void * userData, MBRecognitionEventType type )
+{
+    if ( beginPush( ( RingProducer * ) userData, type ) != NULL )
+    {
+        endPush( ( RingProducer * ) userData );
+    }
+}
+
+static void pushPointsEvent( void * userData, MBRecognitionEventType type, MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus )
+{
+    MBRecognitionEvent * event = beginPush( ( RingProducer * ) userData, type );
+    size_t               storedPoints;
+
+    if ( event == NULL )
+    {
+        return;
+    }
+
+    storedPoints = pointsSize < MB_RECOGNITION_EVENT_MAX_POINTS ? pointsSize : MB_RECOGNITION_EVENT_MAX_POINTS;
+    if ( points != NULL && storedPoints > 0 )
+    {
+        memcpy( event->points, points, storedPoints * sizeof( MBPoint ) );
+    }
+    event->pointsSize      = points != NULL ? pointsSize : 0;
+    event->detectionStatus = detectionStatus;
+
+    endPush( ( RingProducer * ) userData );
+}
+
+static void onDetectionStarted( void * userData )
+{
+    pushSimpleEvent( userData, MB_RECOGNITION_EVENT_DETECTION_STARTED );
+}
+
+static void onDetectionMidway( void * userData, MBPoint const * points, size_t pointsSize )
+{
+    pushPointsEvent( userData, MB_RECOGNITION_EVENT_DETECTION_MIDWAY, points, pointsSize, DETECTION_STATUS_FAIL );
+}
+
+static MBBool onDetectedObject( void * userData, MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus )
+{
+    pushPointsEvent( userData, MB_RECOGNITION_EVENT_DETECTED_OBJECT, points, pointsSize, detectionStatus );
+    return MB_TRUE;
+}
+
+static void onDetectionFailed( void * userData )
+{
+    pushSimpleEvent( userData, MB_RECOGNITION_EVENT_DETECTION_FAILED );
+}
+
+static void onRecognitionStarted( void * userData )
+{
+    pushSimpleEvent( userData, MB_RECOGNITION_EVENT_RECOGNITION_STARTED );
+}
+
+static void onRecognitionFinished( void * userData )
+{
+    pushSimpleEvent( userData, MB_RECOGNITION_EVENT_RECOGNITION_FINISHED );
+}
+
+static void onFirstSideResult( void * userData )
+{
+    pushSimpleEvent( userData, MB_RECOGNITION_EVENT_FIRST_SIDE_RESULT );
+}
+
+static void onGlare( void * userData, MBBool hasGlare )
+{
+    MBRecognitionEvent * event = beginPush( ( RingProducer * ) userData, MB_RECOGNITION_EVENT_GLARE );
+    if ( event != NULL )
+    {
+        event->hasGlare = hasGlare;
+        endPush( ( RingProducer * ) userData );
+    }
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithEventRing
+(
+    MBRecognizerRunner           * recognizerRunner,
+    MBRecognizerImage      const * image,
+    MBBool                         imageIsVideoFrame,
+    MBRecognitionEventRing       * ring,
+    uint64_t                       tag
+)
+{
+    MBUserDataRecognitionCallback callback;
+    RingProducer                  producer;
+
+    if ( ring == NULL )
+    {
+        return recognizerRunnerRecognizeFromImage( recognizerRunner, image, imageIsVideoFrame, NULL );
+    }
+
+    producer.ring = ring;
+    producer.tag  = tag;
+
+    userDataRecognitionCallbackDefaultInit( &callback );
+    callback.userData              = &producer;
+    callback.onDetectionStarted    = onDetectionStarted;
+    callback.onDetectionMidway     = onDetectionMidway;
+    callback.onDetectedObject      = onDetectedObject;
+    callback.onDetectionFailed     = onDetectionFailed;
+    callback.onRecognitionStarted  = onRecognitionStarted;
+    callback.onRecognitionFinished = onRecognitionFinished;
+    callback.onFirstSideResult     = onFirstSideResult;
+    callback.onGlare               = onGlare;
+
+    return recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, image, imageIsVideoFrame, &callback );
+}
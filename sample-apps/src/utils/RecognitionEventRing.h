@@ -0,0 +1,175 @@
+/**
+ * @file RecognitionEventRing.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef RECOGNITION_EVENT_RING_H_
+#define RECOGNITION_EVENT_RING_H_
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum number of points stored in a single MBRecognitionEvent. */
+#define MB_RECOGNITION_EVENT_MAX_POINTS 4
+
+/**
+ * @enum MBRecognitionEventType
+ * @brief Types of recognition events that can be recorded into MBRecognitionEventRing.
+ * Each type corresponds to the MBRecognitionCallback function with the same name.
+ */
+enum MBRecognitionEventType
+{
+    MB_RECOGNITION_EVENT_DETECTION_STARTED,
+    MB_RECOGNITION_EVENT_DETECTION_MIDWAY,
+    MB_RECOGNITION_EVENT_DETECTED_OBJECT,
+    MB_RECOGNITION_EVENT_DETECTION_FAILED,
+    MB_RECOGNITION_EVENT_RECOGNITION_STARTED,
+    MB_RECOGNITION_EVENT_RECOGNITION_FINISHED,
+    MB_RECOGNITION_EVENT_FIRST_SIDE_RESULT,
+    MB_RECOGNITION_EVENT_GLARE
+};
+
+/**
+ * @brief Typedef for MBRecognitionEventType enum.
+ */
+typedef enum MBRecognitionEventType MBRecognitionEventType;
+
+/**
+ * @struct MBRecognitionEvent
+ * @brief Compact record of a single recognition event.
+ */
+struct MBRecognitionEvent
+{
+    /** Tag given to the recognition call that produced this event. */
+    uint64_t tag;
+
+    /** Value of the monotonic clock at which event occured, in nanoseconds. @see ::platformMonotonicNanoseconds */
+    uint64_t timestampNs;
+
+    /** Type of the event. */
+    MBRecognitionEventType type;
+
+    /** Detection status; valid only for MB_RECOGNITION_EVENT_DETECTED_OBJECT events. */
+    MBDetectionStatus detectionStatus;
+
+    /** Whether glare was found; valid only for MB_RECOGNITION_EVENT_GLARE events. */
+    MBBool hasGlare;
+
+    /**
+     * Number of points that were reported with the event. Only the first MB_RECOGNITION_EVENT_MAX_POINTS
+     * points are stored in points array.
+     */
+    size_t pointsSize;
+
+    /** Points reported with MB_RECOGNITION_EVENT_DETECTION_MIDWAY and MB_RECOGNITION_EVENT_DETECTED_OBJECT events. */
+    MBPoint points[ MB_RECOGNITION_EVENT_MAX_POINTS ];
+};
+
+/**
+ * @brief Typedef for MBRecognitionEvent structure.
+ */
+typedef struct MBRecognitionEvent MBRecognitionEvent;
+
+/**
+ * @struct MBRecognitionEventRing
+ * @brief Bounded single-producer single-consumer queue of recognition events.
+ *
+ * Recognition thread writes events into the ring without ever blocking or allocating, while a separate consumer thread
+ * drains them with ::recognitionEventRingPop, so slow event handling (i.e. logging or metrics) does not add to scan
+ * latency. When the ring is full, new events are dropped and counted (@see ::recognitionEventRingDroppedCount).
+ *
+ * At most one thread may produce events into the ring at any time (i.e. ring should be used with a single
+ * MBRecognizerRunner) and at most one thread may consume them.
+ */
+struct MBRecognitionEventRing;
+
+/**
+ * @brief Typedef for MBRecognitionEventRing structure.
+ */
+typedef struct MBRecognitionEventRing MBRecognitionEventRing;
+
+/**
+ * @memberof MBRecognitionEventRing
+ * @brief Allocates and initializes new MBRecognitionEventRing object.
+ * @param ring      Pointer to pointer referencing the created MBRecognitionEventRing object, set to NULL if error occured.
+ * @param capacity  Maximum number of events that ring can hold. Will be rounded up to the nearest power of two.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionEventRingCreate( MBRecognitionEventRing ** ring, size_t capacity );
+
+/**
+ * @memberof MBRecognitionEventRing
+ * @brief Destroys the given MBRecognitionEventRing and sets pointer to it to NULL.
+ * Neither producer nor consumer may use the ring while it is being destroyed.
+ * @param ring  Pointer to pointer to MBRecognitionEventRing that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionEventRingDelete( MBRecognitionEventRing ** ring );
+
+/**
+ * @memberof MBRecognitionEventRing
+ * @brief Moves up to maxEvents oldest events from the ring into given array. Never blocks.
+ * Must be called only from the consumer thread.
+ * @param ring      Ring from which events are taken.
+ * @param events    Array that will receive the events.
+ * @param maxEvents Size of the events array.
+ * @return number of events written into the array, 0 if ring is empty.
+ */
+size_t recognitionEventRingPop( MBRecognitionEventRing * ring, MBRecognitionEvent * events, size_t maxEvents );
+
+/**
+ * @memberof MBRecognitionEventRing
+ * @brief Returns the total number of events that were dropped because the ring was full.
+ * May be called from any thread.
+ * @param ring  Ring of interest.
+ * @return number of dropped events.
+ */
+size_t recognitionEventRingDroppedCount( MBRecognitionEventRing const * ring );
+
+/**
+ * @memberof MBRecognizerRunner
+ * @brief Performs recognition of given image, recording recognition events into the ring instead of calling callbacks.
+ *
+ * This function behaves exactly as ::recognizerRunnerRecognizeFromImage. The calling thread is the producer of the ring.
+ *
+ * @param recognizerRunner      object which performs recognition.
+ * @param image                 MBRecognizerImage object which holds image on which recognition will be performed.
+ * @param imageIsVideoFrame     @see ::recognizerRunnerRecognizeFromImage
+ * @param ring                  Ring into which events will be recorded.
+ * @param tag                   Value that will be stored into every event of this call, i.e. request identifier.
+ *
+ * @return General state of the recognition run. @see ::recognizerRunnerRecognizeFromImage
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithEventRing
+(
+    MBRecognizerRunner           * recognizerRunner,
+    MBRecognizerImage      const * image,
+    MBBool                         imageIsVideoFrame,
+    MBRecognitionEventRing       * ring,
+    uint64_t                       tag
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
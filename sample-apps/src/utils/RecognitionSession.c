@@ -0,0 +1,322 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "RecognitionSession.h"
+#include "Platform.h"
+
+#include <stdlib.h>
+
+/*
+ * Each runner remembers the identifier of the session whose state it holds. Reset of a session only assigns it a new
+ * identifier, so that runners holding its old state no longer match and get reset when handed out.
+ */
+struct MBRecognizerRunnerPool
+{
+    MBPlatformMutex               mutex;
+    MBPlatformCondition           runnerReleased;
+
+    size_t                        runnerCount;
+    MBRecognizerRunner         ** runners;
+    uint64_t                    * owners;
+    uint64_t                    * lastUses;
+    unsigned char               * inUse;
+
+    uint64_t                      lastSessionId;
+    uint64_t                      lastUse;
+    MBRecognizerRunnerPoolStats   stats;
+};
+
+struct MBRecognitionSession
+{
+    MBRecognizerRunnerPool * pool;
+    uint64_t                 id;
+    size_t                   runnerIndex;
+    int                      holdsRunner;
+};
+
+MBRecognizerErrorStatus recognizerRunnerPoolCreate( MBRecognizerRunnerPool ** pool, MBRecognizerRunner * const * runners, size_t runnerCount )
+{
+    MBRecognizerRunnerPool * newPool;
+    size_t                   i;
+
+    if ( pool == NULL || runners == NULL || runnerCount == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+    *pool = NULL;
+
+    for ( i = 0; i < runnerCount; ++i )
+    {
+        if ( runners[ i ] == NULL )
+        {
+            return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+        }
+    }
+
+    newPool = ( MBRecognizerRunnerPool * ) calloc( 1, sizeof( MBRecognizerRunnerPool ) );
+    if ( newPool == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    newPool->runners  = ( MBRecognizerRunner ** ) calloc( runnerCount, sizeof( MBRecognizerRunner * ) );
+    newPool->owners   = ( uint64_t * ) calloc( runnerCount, sizeof( uint64_t ) );
+    newPool->lastUses = ( uint64_t * ) calloc( runnerCount, sizeof( uint64_t ) );
+    newPool->inUse    = ( unsigned char * ) calloc( runnerCount, sizeof( unsigned char ) );
+
+    if ( newPool->runners == NULL || newPool->owners == NULL || newPool->lastUses == NULL || newPool->inUse == NULL )
+    {
+        free( newPool->runners );
+        free( newPool->owners );
+        free( newPool->lastUses );
+        free( newPool->inUse );
+        free( newPool );
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    for ( i = 0; i < runnerCount; ++i )
+    {
+        newPool->runners[ i ] = runners[ i ];
+    }
+    newPool->runnerCount = runnerCount;
+
+    platformMutexInit( &newPool->mutex );
+    platformConditionInit( &newPool->runnerReleased );
+
+    *pool = newPool;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognizerRunnerPoolGetStats( MBRecognizerRunnerPoolStats * stats, MBRecognizerRunnerPool * pool )
+{
+    if ( stats == NULL || pool == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    platformMutexLock( &pool->mutex );
+    *stats = pool->stats;
+    platformMutexUnlock( &pool->mutex );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognizerRunnerPoolDelete( MBRecognizerRunnerPool ** pool )
+{
+    if ( pool == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *pool != NULL )
+    {
+        platformConditionDestroy( &( *pool )->runnerReleased );
+        platformMutexDestroy( &( *pool )->mutex );
+        free( ( *pool )->runners );
+        free( ( *pool )->owners );
+        free( ( *pool )->lastUses );
+        free( ( *pool )->inUse );
+        free( *pool );
+        *pool = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+/* must be called with the pool locked */
+static uint64_t newSessionId( MBRecognizerRunnerPool * pool )
+{
+    return ++pool->lastSessionId;
+}
+
+MBRecognizerErrorStatus recognitionSessionCreate( MBRecognitionSession ** session, MBRecognizerRunnerPool * pool )
+{
+    if ( session == NULL || pool == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *session = ( MBRecognitionSession * ) calloc( 1, sizeof( MBRecognitionSession ) );
+    if ( *session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    ( *session )->pool = pool;
+
+    platformMutexLock( &pool->mutex );
+    ( *session )->id = newSessionId( pool );
+    platformMutexUnlock( &pool->mutex );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+/*
+ * Returns the free runner holding state of the session, otherwise the least recently used free runner, so that state
+ * of other sessions is discarded in the order of their inactivity. Must be called with the pool locked.
+ */
+static size_t findFreeRunner( MBRecognizerRunnerPool const * pool, uint64_t sessionId )
+{
+    size_t best = pool->runnerCount;
+    size_t i;
+
+    for ( i = 0; i < pool->runnerCount; ++i )
+    {
+        if ( pool->inUse[ i ] )
+        {
+            continue;
+        }
+        if ( pool->owners[ i ] == sessionId )
+        {
+            return i;
+        }
+        if ( best == pool->runnerCount || pool->lastUses[ i ] < pool->lastUses[ best ] )
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+MBRecognizerErrorStatus recognitionSessionAcquireRunner( MBRecognitionSession * session, uint32_t timeoutMs, MBRecognizerRunner ** runner, size_t * runnerIndex )
+{
+    MBRecognizerRunnerPool * pool;
+    size_t                   index;
+    uint64_t                 now;
+    uint64_t                 deadline;
+    int                      waited = 0;
+    int                      reset;
+
+    if ( session == NULL || runner == NULL || session->holdsRunner )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    pool     = session->pool;
+    now      = platformMonotonicNanoseconds();
+    deadline = now + ( uint64_t ) timeoutMs * 1000000u;
+
+    platformMutexLock( &pool->mutex );
+
+    for ( ;; )
+    {
+        index = findFreeRunner( pool, session->id );
+        if ( index < pool->runnerCount || now >= deadline )
+        {
+            break;
+        }
+
+        waited = 1;
+        platformConditionWait( &pool->runnerReleased, &pool->mutex, deadline - now );
+        now = platformMonotonicNanoseconds();
+    }
+
+    if ( index == pool->runnerCount )
+    {
+        platformMutexUnlock( &pool->mutex );
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    reset = pool->owners[ index ] != session->id;
+
+    pool->inUse[ index ]    = 1;
+    pool->owners[ index ]   = session->id;
+    pool->lastUses[ index ] = ++pool->lastUse;
+
+    ++pool->stats.acquisitions;
+    if ( reset )
+    {
+        ++pool->stats.resets;
+    }
+    else
+    {
+        ++pool->stats.affinityHits;
+    }
+    if ( waited )
+    {
+        ++pool->stats.waits;
+    }
+
+    platformMutexUnlock( &pool->mutex );
+
+    /* runner is exclusively ours now, so it can be reset without holding the lock */
+    if ( reset )
+    {
+        recognizerRunnerReset( pool->runners[ index ] );
+    }
+
+    session->runnerIndex = index;
+    session->holdsRunner = 1;
+
+    *runner = pool->runners[ index ];
+    if ( runnerIndex != NULL )
+    {
+        *runnerIndex = index;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognitionSessionReleaseRunner( MBRecognitionSession * session )
+{
+    MBRecognizerRunnerPool * pool;
+
+    if ( session == NULL || !session->holdsRunner )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    pool = session->pool;
+
+    platformMutexLock( &pool->mutex );
+    pool->inUse[ session->runnerIndex ] = 0;
+    platformConditionBroadcast( &pool->runnerReleased );
+    platformMutexUnlock( &pool->mutex );
+
+    session->holdsRunner = 0;
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognitionSessionReset( MBRecognitionSession * session )
+{
+    if ( session == NULL || session->holdsRunner )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    platformMutexLock( &session->pool->mutex );
+    session->id = newSessionId( session->pool );
+    platformMutexUnlock( &session->pool->mutex );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus recognitionSessionDelete( MBRecognitionSession ** session )
+{
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *session != NULL )
+    {
+        if ( ( *session )->holdsRunner )
+        {
+            recognitionSessionReleaseRunner( *session );
+        }
+        free( *session );
+        *session = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file RecognitionSession.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef RECOGNITION_SESSION_H_
+#define RECOGNITION_SESSION_H_
+
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBRecognizerRunnerPool
+ * @brief Set of warm recognizer runners shared by many streams, each represented by MBRecognitionSession.
+ *
+ * Multi-frame accumulation state of video recognition is kept inside the recognizers, so a runner can follow only one
+ * stream at a time. The pool hands runners to sessions on demand and remembers which session used each runner last:
+ * a session gets back its own runner with the accumulated state whenever it is free, and a runner that last served
+ * a different stream is reset before it is handed out, so state of one stream never leaks into another. With more
+ * streams than runners, streams that are recognized in turn lose their accumulated state, but memory stays bounded
+ * by the number of runners instead of growing with the number of streams.
+ *
+ * Pool does not own the runners, which must outlive the pool. Pool can be used from multiple threads.
+ */
+struct MBRecognizerRunnerPool;
+
+/**
+ * @brief Typedef for MBRecognizerRunnerPool structure.
+ */
+typedef struct MBRecognizerRunnerPool MBRecognizerRunnerPool;
+
+/**
+ * @struct MBRecognizerRunnerPoolStats
+ * @brief Counters of MBRecognizerRunnerPool.
+ */
+struct MBRecognizerRunnerPoolStats
+{
+    /** Number of times a runner was handed to a session. */
+    size_t acquisitions;
+
+    /** Number of acquisitions that returned the runner last used by the same session, keeping its accumulated state. */
+    size_t affinityHits;
+
+    /** Number of acquisitions that had to reset the runner, i.e. because it last served a different session. */
+    size_t resets;
+
+    /** Number of acquisitions that had to wait for a runner to be released. */
+    size_t waits;
+};
+
+/**
+ * @brief Typedef for MBRecognizerRunnerPoolStats structure.
+ */
+typedef struct MBRecognizerRunnerPoolStats MBRecognizerRunnerPoolStats;
+
+/**
+ * @memberof MBRecognizerRunnerPool
+ * @brief Allocates and initializes new MBRecognizerRunnerPool object.
+ * @param pool          Pointer to pointer referencing the created object.
+ * @param runners       Array of runners, each with its own set of recognizers. All runners should have recognizers of
+ *                      the same types and settings, so that it does not matter which of them recognizes a frame.
+ * @param runnerCount   Number of runners in the array.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognizerRunnerPoolCreate( MBRecognizerRunnerPool ** pool, MBRecognizerRunner * const * runners, size_t runnerCount );
+
+/**
+ * @memberof MBRecognizerRunnerPool
+ * @brief Obtains counters of the pool.
+ * @param stats Structure that will receive the counters.
+ * @param pool  Pool of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognizerRunnerPoolGetStats( MBRecognizerRunnerPoolStats * stats, MBRecognizerRunnerPool * pool );
+
+/**
+ * @memberof MBRecognizerRunnerPool
+ * @brief Destroys the given MBRecognizerRunnerPool and sets pointer to it to NULL. All sessions of the pool must have
+ * been deleted already. Runners are not deleted.
+ * @param pool  Pointer to pointer to MBRecognizerRunnerPool that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognizerRunnerPoolDelete( MBRecognizerRunnerPool ** pool );
+
+/**
+ * @struct MBRecognitionSession
+ * @brief Lightweight state of a single stream, which borrows runners from MBRecognizerRunnerPool for each frame.
+ *
+ * Example:
+ * @code
+ *   MBRecognizerRunner * runner;
+ *   size_t               runnerIndex;
+ *
+ *   if ( recognitionSessionAcquireRunner( session, 100, &runner, &runnerIndex ) == MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+ *   {
+ *       recognizerRunnerRecognizeFromImage( runner, frame, MB_TRUE, NULL );
+ *       // obtain results from recognizers of the runner at runnerIndex
+ *       recognitionSessionReleaseRunner( session );
+ *   }
+ * @endcode
+ *
+ * Single session must not be used from multiple threads at the same time, while different sessions may.
+ */
+struct MBRecognitionSession;
+
+/**
+ * @brief Typedef for MBRecognitionSession structure.
+ */
+typedef struct MBRecognitionSession MBRecognitionSession;
+
+/**
+ * @memberof MBRecognitionSession
+ * @brief Allocates and initializes new MBRecognitionSession object.
+ * @param session   Pointer to pointer referencing the created object.
+ * @param pool      Pool from which the session borrows runners.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionSessionCreate( MBRecognitionSession ** session, MBRecognizerRunnerPool * pool );
+
+/**
+ * @memberof MBRecognitionSession
+ * @brief Borrows a runner from the pool, preferring the runner last used by the session.
+ * If the runner last served a different session, or the session was reset, the runner is reset before it is returned.
+ * @param session       Session of interest, which must not already hold a runner.
+ * @param timeoutMs     Maximum time to wait for a runner to be released by another session, in milliseconds.
+ * @param runner        Receives the borrowed runner, which may be used until ::recognitionSessionReleaseRunner.
+ * @param runnerIndex   If not NULL, receives index of the runner in the array given to ::recognizerRunnerPoolCreate,
+ *                      i.e. for finding its recognizers.
+ * @return status of the operation. MB_RECOGNIZER_ERROR_STATUS_FAIL is returned if no runner was released in time.
+ */
+MBRecognizerErrorStatus recognitionSessionAcquireRunner( MBRecognitionSession * session, uint32_t timeoutMs, MBRecognizerRunner ** runner, size_t * runnerIndex );
+
+/**
+ * @memberof MBRecognitionSession
+ * @brief Returns the borrowed runner to the pool. Its accumulated state is kept for the next acquisition by the session.
+ * @param session   Session of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionSessionReleaseRunner( MBRecognitionSession * session );
+
+/**
+ * @memberof MBRecognitionSession
+ * @brief Discards the accumulated state of the stream, i.e. when a new document is presented. The next acquired runner
+ * is reset. Session must not hold a runner.
+ * @param session   Session of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionSessionReset( MBRecognitionSession * session );
+
+/**
+ * @memberof MBRecognitionSession
+ * @brief Destroys the given MBRecognitionSession and sets pointer to it to NULL, releasing its runner if it holds one.
+ * @param session   Pointer to pointer to MBRecognitionSession that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognitionSessionDelete( MBRecognitionSession ** session );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "RecognitionStats.h"
+#include "Platform.h"
+
+#include <string.h>
+
+enum StatsPhase
+{
+    STATS_PHASE_PREPARATION,
+    STATS_PHASE_DETECTION,
+    STATS_PHASE_PROCESSING,
+    STATS_PHASE_IDLE
+};
+
+typedef struct StatsCollector
+{
+    MBRecognitionStats                  * stats;
+    MBUserDataRecognitionCallback const * userCallback;
+    enum StatsPhase                       phase;
+    uint64_t                              phaseStart;
+} StatsCollector;
+
+static MBDetectionAttemptStats * currentAttempt( StatsCollector * collector )
+{
+    MBRecognitionStats * stats = collector->stats;
+    if ( stats->numDetectionAttempts == 0 || stats->numDetectionAttempts > MB_RECOGNITION_STATS_MAX_ATTEMPTS )
+    {
+        return NULL;
+    }
+    return &stats->attempts[ stats->numDetectionAttempts - 1 ];
+}
+
+/* closes currently running stage and starts the new one at given time */
+static void switchPhase( StatsCollector * collector, enum StatsPhase newPhase, uint64_t now )
+{
+    MBRecognitionStats      * stats    = collector->stats;
+    MBDetectionAttemptStats * attempt  = currentAttempt( collector );
+    uint64_t                  duration = now - collector->phaseStart;
+
+    switch ( collector->phase )
+    {
+        case STATS_PHASE_PREPARATION:
+            stats->preparationNs += duration;
+            break;
+        case STATS_PHASE_DETECTION:
+            stats->detectionNs += duration;
+            if ( attempt != NULL ) attempt->detectionNs += duration;
+            break;
+        case STATS_PHASE_PROCESSING:
+            stats->processingNs += duration;
+            if ( attempt != NULL ) attempt->processingNs += duration;
+            break;
+        default:
+            break;
+    }
+
+    collector->phase      = newPhase;
+    collector->phaseStart = now;
+}
+
+static void beginAttempt( StatsCollector * collector, uint64_t now )
+{
+    MBRecognitionStats * stats = collector->stats;
+
+    switchPhase( collector, STATS_PHASE_DETECTION, now );
+
+    ++stats->numDetectionAttempts;
+    if ( stats->numDetectionAttempts <= MB_RECOGNITION_STATS_MAX_ATTEMPTS )
+    {
+        stats->numRecordedAttempts = stats->numDetectionAttempts;
+        stats->attempts[ stats->numDetectionAttempts - 1 ].status = DETECTION_STATUS_FAIL;
+    }
+}
+
+static void onDetectionStarted( void * userData )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+
+    beginAttempt( collector, platformMonotonicNanoseconds() );
+
+    if ( collector->userCallback->onDetectionStarted != NULL )
+    {
+        collector->userCallback->onDetectionStarted( collector->userCallback->userData );
+    }
+}
+
+static void onDetectionMidway( void * userData, MBPoint const * points, size_t pointsSize )
+{
+    StatsCollector          * collector = ( StatsCollector * ) userData;
+    MBDetectionAttemptStats * attempt   = currentAttempt( collector );
+
+    ++collector->stats->numCandidates;
+    if ( attempt != NULL ) ++attempt->numCandidates;
+
+    if ( collector->userCallback->onDetectionMidway != NULL )
+    {
+        collector->userCallback->onDetectionMidway( collector->userCallback->userData, points, pointsSize );
+    }
+}
+
+static MBBool onDetectedObject( void * userData, MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus )
+{
+    StatsCollector          * collector = ( StatsCollector * ) userData;
+    MBDetectionAttemptStats * attempt;
+    uint64_t                  now       = platformMonotonicNanoseconds();
+    MBBool                    proceed   = MB_TRUE;
+
+    /* some detectors report their result without announcing the start of detection */
+    if ( collector->phase != STATS_PHASE_DETECTION )
+    {
+        beginAttempt( collector, now );
+    }
+
+    attempt = currentAttempt( collector );
+    if ( attempt != NULL ) attempt->status = detectionStatus;
+
+    if ( collector->userCallback->onDetectedObject != NULL )
+    {
+        proceed = collector->userCallback->onDetectedObject( collector->userCallback->userData, points, pointsSize, detectionStatus );
+    }
+
+    if ( detectionStatus == DETECTION_STATUS_SUCCESS && proceed )
+    {
+        switchPhase( collector, STATS_PHASE_PROCESSING, now );
+    }
+    else
+    {
+        ++collector->stats->numFailedDetections;
+        switchPhase( collector, STATS_PHASE_IDLE, now );
+    }
+
+    return proceed;
+}
+
+static void onRecognitionFinished( void * userData )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+
+    switchPhase( collector, STATS_PHASE_IDLE, platformMonotonicNanoseconds() );
+
+    if ( collector->userCallback->onRecognitionFinished != NULL )
+    {
+        collector->userCallback->onRecognitionFinished( collector->userCallback->userData );
+    }
+}
+
+static void onGlare( void * userData, MBBool hasGlare )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+
+    if ( hasGlare ) ++collector->stats->numGlareDetections;
+
+    if ( collector->userCallback->onGlare != NULL )
+    {
+        collector->userCallback->onGlare( collector->userCallback->userData, hasGlare );
+    }
+}
+
+static void onDetectionFailed( void * userData )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+    collector->userCallback->onDetectionFailed( collector->userCallback->userData );
+}
+
+static void onRecognitionStarted( void * userData )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+    collector->userCallback->onRecognitionStarted( collector->userCallback->userData );
+}
+
+static void onShowImage( void * userData, MBRecognizerImage const * image, MBShowImageType showType, char const * name )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+    collector->userCallback->onShowImage( collector->userCallback->userData, image, showType, name );
+}
+
+static void onFirstSideResult( void * userData )
+{
+    StatsCollector * collector = ( StatsCollector * ) userData;
+    collector->userCallback->onFirstSideResult( collector->userCallback->userData );
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithStats
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback,
+    MBRecognitionStats                  * stats
+)
+{
+    MBUserDataRecognitionCallback emptyCallback;
+    MBUserDataRecognitionCallback statsCallback;
+    StatsCollector                collector;
+    uint64_t                      callStart;
+
+    if ( stats == NULL )
+    {
+        return recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, image, imageIsVideoFrame, callback );
+    }
+
+    if ( callback == NULL )
+    {
+        userDataRecognitionCallbackDefaultInit( &emptyCallback );
+        callback = &emptyCallback;
+    }
+
+    memset( stats, 0, sizeof( MBRecognitionStats ) );
+
+    /*
+     * Only events that delimit the stages are always registered. All other events, including glare and midway
+     * detection which may enable additional work inside the SDK and thus change the measured timings, are
+     * registered only if user handles them.
+     */
+    userDataRecognitionCallbackDefaultInit( &statsCallback );
+    statsCallback.userData              = &collector;
+    statsCallback.onDetectionFailed     = callback->onDetectionFailed    != NULL ? onDetectionFailed    : NULL;
+    statsCallback.onRecognitionStarted  = callback->onRecognitionStarted != NULL ? onRecognitionStarted : NULL;
+    statsCallback.onShowImage           = callback->onShowImage          != NULL ? onShowImage          : NULL;
+    statsCallback.showImageTypes        = callback->showImageTypes;
+    statsCallback.onFirstSideResult     = callback->onFirstSideResult    != NULL ? onFirstSideResult    : NULL;
+    statsCallback.onDetectionStarted    = onDetectionStarted;
+    statsCallback.onDetectionMidway     = callback->onDetectionMidway    != NULL ? onDetectionMidway    : NULL;
+    statsCallback.onDetectedObject      = onDetectedObject;
+    statsCallback.onRecognitionFinished = onRecognitionFinished;
+    statsCallback.onGlare               = callback->onGlare              != NULL ? onGlare              : NULL;
+
+    callStart = platformMonotonicNanoseconds();
+
+    collector.stats        = stats;
+    collector.userCallback = callback;
+    collector.phase        = STATS_PHASE_PREPARATION;
+    collector.phaseStart   = callStart;
+
+    stats->resultState = recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, image, imageIsVideoFrame, &statsCallback );
+
+    switchPhase( &collector, STATS_PHASE_IDLE, platformMonotonicNanoseconds() );
+    stats->totalNs = collector.phaseStart - callStart;
+
+    return stats->resultState;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file RecognitionStats.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef RECOGNITION_STATS_H_
+#define RECOGNITION_STATS_H_
+
+#include "UserDataRecognitionCallback.h"
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum number of detection attempts whose timings are recorded individually in MBRecognitionStats. */
+#define MB_RECOGNITION_STATS_MAX_ATTEMPTS 8
+
+/**
+ * @struct MBDetectionAttemptStats
+ * @brief Timings of a single object detection attempt performed during recognition.
+ */
+struct MBDetectionAttemptStats
+{
+    /** Time spent searching for the object, in nanoseconds. */
+    uint64_t detectionNs;
+
+    /**
+     * Time spent processing the detected object (i.e. barcode decoding, error correction and
+     * payment data parsing), in nanoseconds. 0 if detection failed.
+     */
+    uint64_t processingNs;
+
+    /** Number of intermediate candidates reported while detection was in progress, if callback handles onDetectionMidway. */
+    size_t numCandidates;
+
+    /** Status with which the detection finished. */
+    MBDetectionStatus status;
+};
+
+/**
+ * @brief Typedef for MBDetectionAttemptStats structure.
+ */
+typedef struct MBDetectionAttemptStats MBDetectionAttemptStats;
+
+/**
+ * @struct MBRecognitionStats
+ * @brief Timings and counters of a single recognition call.
+ *
+ * Stages are delimited by recognition events reported by the SDK, using monotonic clock:
+ *  - preparation: from the start of the call until the first detection starts (image conversion and preprocessing)
+ *  - detection: from each onDetectionStarted until the matching onDetectedObject
+ *  - processing: from each successful onDetectedObject until the next detection starts or recognition finishes
+ *
+ * Recognizers in MBRecognizerRunner process the image in the order in which they are given in MBRecognizerRunnerSettings,
+ * so when each recognizer performs a single detection, attempts[ i ] corresponds to the i-th recognizer in the chain.
+ */
+struct MBRecognitionStats
+{
+    /** Total duration of the recognition call, in nanoseconds. */
+    uint64_t totalNs;
+
+    /** Duration of the preparation stage, in nanoseconds. */
+    uint64_t preparationNs;
+
+    /** Total duration of all detection stages, in nanoseconds. */
+    uint64_t detectionNs;
+
+    /** Total duration of all processing stages, in nanoseconds. */
+    uint64_t processingNs;
+
+    /** Number of detection attempts performed by all recognizers. */
+    size_t numDetectionAttempts;
+
+    /** Number of detection attempts that did not find the object. */
+    size_t numFailedDetections;
+
+    /** Total number of intermediate candidates reported while detection was in progress, if callback handles onDetectionMidway. */
+    size_t numCandidates;
+
+    /** Number of glare detections that found glare on the image, if callback handles onGlare. */
+    size_t numGlareDetections;
+
+    /** Number of valid elements in attempts array, at most MB_RECOGNITION_STATS_MAX_ATTEMPTS. */
+    size_t numRecordedAttempts;
+
+    /** Timings of the first MB_RECOGNITION_STATS_MAX_ATTEMPTS detection attempts. */
+    MBDetectionAttemptStats attempts[ MB_RECOGNITION_STATS_MAX_ATTEMPTS ];
+
+    /** State returned by the recognition call. */
+    MBRecognizerResultState resultState;
+};
+
+/**
+ * @brief Typedef for MBRecognitionStats structure.
+ */
+typedef struct MBRecognitionStats MBRecognitionStats;
+
+/**
+ * @memberof MBRecognizerRunner
+ * @brief Performs recognition of given image and optionally measures where the time was spent.
+ *
+ * When stats is NULL, this function is equivalent to ::recognizerRunnerRecognizeFromImageWithUserData and
+ * performs no measurements, so instrumentation can be left in place in production code.
+ *
+ * @param recognizerRunner      object which performs recognition.
+ * @param image                 MBRecognizerImage object which holds image on which recognition will be performed.
+ * @param imageIsVideoFrame     @see ::recognizerRunnerRecognizeFromImage
+ * @param callback              Callbacks that should receive recognition events, or NULL.
+ * @param stats                 Structure that will be overwritten with statistics of this call, or NULL to disable measuring.
+ *
+ * @return General state of the recognition run. @see ::recognizerRunnerRecognizeFromImage
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithStats
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback,
+    MBRecognitionStats                  * stats
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
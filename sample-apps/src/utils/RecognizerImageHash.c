@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "RecognizerImageHash.h"
+#include "RecognizerImageUtils.h"
+
+#include <string.h>
+
+/* dimensions of the thumbnail used for perceptual hash, which yields 8 differences in each of 8 rows */
+#define DHASH_WIDTH  9
+#define DHASH_HEIGHT 8
+
+/* primes of xxHash64, whose round function is used for mixing */
+#define PRIME_1 0x9E3779B185EBCA87ull
+#define PRIME_2 0xC2B2AE3D27D4EB4Full
+#define PRIME_3 0x165667B19E3779F9ull
+
+static uint64_t rotateLeft( uint64_t value, int bits )
+{
+    return ( value << bits ) | ( value >> ( 64 - bits ) );
+}
+
+static uint64_t mixWord( uint64_t hash, uint64_t word )
+{
+    word *= PRIME_2;
+    word  = rotateLeft( word, 31 );
+    word *= PRIME_1;
+    hash ^= word;
+    return rotateLeft( hash, 27 ) * PRIME_1 + PRIME_3;
+}
+
+static uint64_t finalize( uint64_t hash )
+{
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static uint64_t mixBytes( uint64_t hash, MBByte const * bytes, size_t length )
+{
+    uint64_t word;
+    size_t   i;
+
+    for ( i = 0; i + 8 <= length; i += 8 )
+    {
+        /* memcpy avoids unaligned access and is compiled into a single load */
+        memcpy( &word, bytes + i, 8 );
+        hash = mixWord( hash, word );
+    }
+
+    if ( i < length )
+    {
+        word = 0;
+        memcpy( &word, bytes + i, length - i );
+        hash = mixWord( hash, word ^ ( uint64_t ) ( length - i ) );
+    }
+
+    return hash;
+}
+
+uint64_t recognizerImageContentHash( MBRecognizerImage const * image )
+{
+    MBByte const * pixels;
+    MBRawImageType rawType;
+    uint16_t       width, height, bytesPerRow;
+    size_t         rowLength, rows, row;
+    int            bytesPerPixel;
+    uint64_t       hash;
+
+    if ( image == NULL )
+    {
+        return 0;
+    }
+
+    pixels        = recognizerImageGetRawBytes( image );
+    rawType       = recognizerImageGetRawImageType( image );
+    width         = recognizerImageGetWidth( image );
+    height        = recognizerImageGetHeight( image );
+    bytesPerRow   = recognizerImageGetBytesPerRow( image );
+    bytesPerPixel = recognizerImageRawTypeBytesPerPixel( rawType );
+
+    if ( bytesPerPixel > 0 )
+    {
+        rowLength = ( size_t ) width * bytesPerPixel;
+        rows      = height;
+    }
+    else
+    {
+        /* NV21: full resolution luma plane followed by interleaved chroma plane of half height */
+        rowLength = width;
+        rows      = height + ( height + 1u ) / 2u;
+    }
+
+    hash = PRIME_3;
+    hash = mixWord( hash, ( ( uint64_t ) width << 32 ) | ( ( uint64_t ) height << 16 ) | ( uint64_t ) rawType );
+    hash = mixWord( hash, ( uint64_t ) recognizerImageGetImageOrientation( image ) );
+
+    for ( row = 0; row < rows && pixels != NULL; ++row )
+    {
+        hash = mixBytes( hash, pixels + row * bytesPerRow, rowLength );
+    }
+
+    return finalize( hash );
+}
+
+uint64_t recognizerHashCombine( uint64_t first, uint64_t second )
+{
+    return finalize( mixWord( mixWord( PRIME_3, first ), second ) );
+}
+
+uint64_t recognizerImagePerceptualHash( MBRecognizerImage const * image )
+{
+    MBByte   thumbnail[ DHASH_WIDTH * DHASH_HEIGHT ];
+    uint64_t hash = 0;
+    int      x, y;
+
+    if ( recognizerImageSampleLuma( image, thumbnail, DHASH_WIDTH, DHASH_HEIGHT ) != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return 0;
+    }
+
+    for ( y = 0; y < DHASH_HEIGHT; ++y )
+    {
+        for ( x = 0; x < DHASH_WIDTH - 1; ++x )
+        {
+            hash = ( hash << 1 ) | ( thumbnail[ y * DHASH_WIDTH + x ] > thumbnail[ y * DHASH_WIDTH + x + 1 ] );
+        }
+    }
+
+    return hash;
+}
+
+int recognizerHashHammingDistance( uint64_t first, uint64_t second )
+{
+    uint64_t difference = first ^ second;
+    int      distance   = 0;
+
+    /* clears lowest set bit in each step, so the loop runs once per differing bit */
+    while ( difference != 0 )
+    {
+        difference &= difference - 1;
+        ++distance;
+    }
+
+    return distance;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file RecognizerImageHash.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef RECOGNIZER_IMAGE_HASH_H_
+#define RECOGNIZER_IMAGE_HASH_H_
+
+#include <Recognizer/RecognizerImage.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Computes 64-bit hash of the image contents.
+ * Only pixels are hashed, i.e. padding at the end of rows is ignored, so the same image stored with different
+ * bytes per row has the same hash. Dimensions, raw image type and orientation are part of the hash.
+ * The hash processes 8 bytes per step, so hashing is much cheaper than recognition of the image.
+ * @param image Image of interest.
+ * @return hash of the image, or 0 if image is NULL.
+ */
+uint64_t recognizerImageContentHash( MBRecognizerImage const * image );
+
+/**
+ * @brief Combines two 64-bit hashes into one, i.e. image hash with hash of recognizer settings.
+ * @param first     First hash.
+ * @param second    Second hash.
+ * @return combined hash, which depends on order of arguments.
+ */
+uint64_t recognizerHashCombine( uint64_t first, uint64_t second );
+
+/**
+ * @brief Computes 64-bit perceptual (difference) hash of the image.
+ * Image is reduced to 9x8 luma thumbnail and each bit of the hash tells whether the thumbnail pixel is brighter than its
+ * right neighbour. Re-encoded, rescaled, slightly cropped or slightly differently exposed copies of the same image
+ * therefore have hashes that differ in only a few bits, see ::recognizerHashHammingDistance.
+ * @param image Image of interest.
+ * @return perceptual hash of the image, or 0 if image is NULL.
+ */
+uint64_t recognizerImagePerceptualHash( MBRecognizerImage const * image );
+
+/**
+ * @brief Returns the number of bits in which the given hashes differ.
+ * @param first     First hash.
+ * @param second    Second hash.
+ * @return Hamming distance, from 0 to 64.
+ */
+int recognizerHashHammingDistance( uint64_t first, uint64_t second );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "RecognizerImageUtils.h"
+
+#include <stddef.h>
+
+int recognizerImageRawTypeBytesPerPixel( MBRawImageType rawType )
+{
+    switch ( rawType )
+    {
+        case MB_RAW_IMAGE_TYPE_BGRA:
+        case MB_RAW_IMAGE_TYPE_RGBA:
+            return 4;
+        case MB_RAW_IMAGE_TYPE_BGR:
+        case MB_RAW_IMAGE_TYPE_RGB:
+            return 3;
+        case MB_RAW_IMAGE_TYPE_GRAY:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+MBRecognizerErrorStatus recognizerImageCreateView( MBRecognizerImage ** view, MBRecognizerImage const * parent, uint16_t x, uint16_t y, uint16_t width, uint16_t height )
+{
+    MBRawImageType          rawType;
+    MBByte          const * parentBytes;
+    int                     bytesPerPixel;
+    uint16_t                bytesPerRow;
+    MBRecognizerErrorStatus status;
+
+    if ( view == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    *view = NULL;
+
+    if ( parent == NULL || width == 0 || height == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* compare in int to avoid uint16_t overflow of x + width */
+    if ( ( int ) x + width > recognizerImageGetWidth( parent ) || ( int ) y + height > recognizerImageGetHeight( parent ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    rawType       = recognizerImageGetRawImageType( parent );
+    bytesPerPixel = recognizerImageRawTypeBytesPerPixel( rawType );
+    if ( bytesPerPixel == 0 )
+    {
+        /* chroma plane of NV21 image is located after the luma plane, so it cannot be addressed with a single offset */
+        return MB_RECOGNIZER_ERROR_STATUS_NOT_SUPPORTED;
+    }
+
+    parentBytes = recognizerImageGetRawBytes( parent );
+    if ( parentBytes == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    bytesPerRow = recognizerImageGetBytesPerRow( parent );
+
+    status = recognizerImageCreateFromRawImage
+    (
+        view,
+        parentBytes + ( size_t ) y * bytesPerRow + ( size_t ) x * bytesPerPixel,
+        width,
+        height,
+        bytesPerRow,
+        rawType
+    );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    status = recognizerImageSetImageOrientation( *view, recognizerImageGetImageOrientation( parent ) );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        recognizerImageDelete( view );
+    }
+
+    return status;
+}
+
+/* number of samples taken along each axis of a thumbnail pixel */
+#define LUMA_SAMPLES 8
+
+MBRecognizerErrorStatus recognizerImageSampleLuma( MBRecognizerImage const * image, MBByte * thumbnail, int thumbnailWidth, int thumbnailHeight )
+{
+    MBByte const * pixels;
+    int            width, height, bytesPerRow, bytesPerPixel;
+    int            tx, ty, sx, sy;
+
+    if ( image == NULL || thumbnail == NULL || thumbnailWidth <= 0 || thumbnailHeight <= 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    pixels        = recognizerImageGetRawBytes( image );
+    width         = recognizerImageGetWidth( image );
+    height        = recognizerImageGetHeight( image );
+    bytesPerRow   = recognizerImageGetBytesPerRow( image );
+    bytesPerPixel = recognizerImageRawTypeBytesPerPixel( recognizerImageGetRawImageType( image ) );
+
+    if ( pixels == NULL || width == 0 || height == 0 )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    for ( ty = 0; ty < thumbnailHeight; ++ty )
+    {
+        /* area of the image covered by the thumbnail row, never empty */
+        int top    = ( int ) ( ( long ) ty * height / thumbnailHeight );
+        int bottom = ( int ) ( ( long ) ( ty + 1 ) * height / thumbnailHeight );
+        if ( bottom <= top ) bottom = top + 1;
+
+        for ( tx = 0; tx < thumbnailWidth; ++tx )
+        {
+            int  left  = ( int ) ( ( long ) tx * width / thumbnailWidth );
+            int  right = ( int ) ( ( long ) ( tx + 1 ) * width / thumbnailWidth );
+            long sum   = 0;
+
+            if ( right <= left ) right = left + 1;
+
+            for ( sy = 0; sy < LUMA_SAMPLES; ++sy )
+            {
+                int            y   = top + ( 2 * sy + 1 ) * ( bottom - top ) / ( 2 * LUMA_SAMPLES );
+                MBByte const * row = pixels + ( size_t ) y * bytesPerRow;
+
+                for ( sx = 0; sx < LUMA_SAMPLES; ++sx )
+                {
+                    sum += recognizerImagePixelLuma( row, left + ( 2 * sx + 1 ) * ( right - left ) / ( 2 * LUMA_SAMPLES ), bytesPerPixel );
+                }
+            }
+
+            thumbnail[ ty * thumbnailWidth + tx ] = ( MBByte ) ( sum / ( LUMA_SAMPLES * LUMA_SAMPLES ) );
+        }
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file RecognizerImageUtils.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef RECOGNIZER_IMAGE_UTILS_H_
+#define RECOGNIZER_IMAGE_UTILS_H_
+
+#include "Platform.h"
+
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/Types.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Returns the number of bytes that single pixel occupies in the given raw image type.
+ * @param rawType   raw image type of interest
+ * @return number of bytes per pixel, or 0 for planar types (i.e. MB_RAW_IMAGE_TYPE_NV21), where
+ *         pixel size is not well defined.
+ */
+int recognizerImageRawTypeBytesPerPixel( MBRawImageType rawType );
+
+/**
+ * @brief Returns luma of a single pixel, approximated as (R + 2G + B) / 4 for color pixels.
+ * @param row           First byte of the row containing the pixel. For NV21 images, row of the luma plane.
+ * @param x             Horizontal position of the pixel within the row.
+ * @param bytesPerPixel Value returned by ::recognizerImageRawTypeBytesPerPixel for the image.
+ * @return luma, from 0 to 255.
+ */
+static MB_INLINE int recognizerImagePixelLuma( MBByte const * row, int x, int bytesPerPixel )
+{
+    MBByte const * pixel;
+
+    if ( bytesPerPixel <= 1 )
+    {
+        return row[ x ];
+    }
+
+    /* symmetric weights, so the result does not depend on the channel order */
+    pixel = row + x * bytesPerPixel;
+    return ( pixel[ 0 ] + 2 * pixel[ 1 ] + pixel[ 2 ] ) >> 2;
+}
+
+/**
+  @memberof MBRecognizerImage
+  @brief Allocates and creates MBRecognizerImage object that views a rectangular part of another MBRecognizerImage.
+  NOTE: This function will not make copy of the pixels. Created view points directly into the buffer of the parent image
+  and uses the parent's bytes per row, so make sure that parent image (and its buffer) stays alive and unchanged while
+  the view is in use. The view inherits the orientation of the parent image.
+
+  Unlike ::recognizerRunnerSetROI, creating a view does not modify any MBRecognizerRunner, so multiple threads
+  may create different views of the same parent image and process them concurrently with separate runners.
+
+  Example:
+  @code
+    MBRecognizerImage *view;
+    MBRecognizerErrorStatus status = recognizerImageCreateView(&view, image, 100, 200, 640, 480);
+
+    if (status == MB_RECOGNIZER_ERROR_STATUS_SUCCESS) {
+        recognizerRunnerRecognizeFromImage(runner, view, MB_FALSE, NULL);
+        recognizerImageDelete(&view);
+    }
+  @endcode
+
+  @param     view                Pointer to pointer referencing the created MBRecognizerImage object, set to NULL if error occured.
+  @param     parent              Image whose pixels will be viewed. Must not be of type MB_RAW_IMAGE_TYPE_NV21.
+  @param     x                   Horizontal position of the view within parent, in pixels
+  @param     y                   Vertical position of the view within parent, in pixels
+  @param     width               Width of the view, in pixels
+  @param     height              Height of the view, in pixels
+  @return    errorStatus         Status of the operation. MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT is returned if the
+                                 requested rectangle is empty or does not fit into the parent image, and
+                                 MB_RECOGNIZER_ERROR_STATUS_NOT_SUPPORTED is returned for planar (NV21) parent images.
+ */
+MBRecognizerErrorStatus recognizerImageCreateView( MBRecognizerImage ** view, MBRecognizerImage const * parent, uint16_t x, uint16_t y, uint16_t width, uint16_t height );
+
+/**
+ * @brief Computes small grayscale thumbnail of the image, i.e. for perceptual hashing or quality estimation.
+ * Every thumbnail pixel is the average luma of a regular grid of at most 8x8 samples taken from the corresponding
+ * area of the image, so the cost does not depend on the image resolution. Luma of color images is approximated as
+ * (R + 2G + B) / 4; for NV21 images the luma plane is used.
+ * @param image             Image of interest. Image orientation is ignored.
+ * @param thumbnail         Buffer of thumbnailWidth * thumbnailHeight bytes that will receive the thumbnail, row by row.
+ * @param thumbnailWidth    Width of the thumbnail, in pixels.
+ * @param thumbnailHeight   Height of the thumbnail, in pixels.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus recognizerImageSampleLuma( MBRecognizerImage const * image, MBByte * thumbnail, int thumbnailWidth, int thumbnailHeight );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
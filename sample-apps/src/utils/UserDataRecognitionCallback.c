@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "UserDataRecognitionCallback.h"
+#include "Platform.h"
+
+#include <string.h>
+
+/*
+ * MBRecognitionCallback functions are invoked synchronously on the thread that called recognizerRunnerRecognizeFrom*,
+ * so the callback structure of the ongoing call is kept in a thread local variable and trampolines forward events to it.
+ */
+static MB_THREAD_LOCAL MBUserDataRecognitionCallback const * currentCallback = NULL;
+
+static void onDetectionStartedTrampoline( void )
+{
+    currentCallback->onDetectionStarted( currentCallback->userData );
+}
+
+static void onDetectionMidwayTrampoline( MBPoint const * points, size_t pointsSize )
+{
+    currentCallback->onDetectionMidway( currentCallback->userData, points, pointsSize );
+}
+
+static MBBool onDetectedObjectTrampoline( MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus )
+{
+    return currentCallback->onDetectedObject( currentCallback->userData, points, pointsSize, detectionStatus );
+}
+
+static void onDetectionFailedTrampoline( void )
+{
+    currentCallback->onDetectionFailed( currentCallback->userData );
+}
+
+static void onRecognitionStartedTrampoline( void )
+{
+    currentCallback->onRecognitionStarted( currentCallback->userData );
+}
+
+static void onRecognitionFinishedTrampoline( void )
+{
+    currentCallback->onRecognitionFinished( currentCallback->userData );
+}
+
+static void onShowImageTrampoline( MBRecognizerImage const * image, MBShowImageType showType, char const * name )
+{
+    if ( currentCallback->showImageTypes & MB_SHOW_IMAGE_TYPE_BIT( showType ) )
+    {
+        currentCallback->onShowImage( currentCallback->userData, image, showType, name );
+    }
+}
+
+static void onFirstSideResultTrampoline( void )
+{
+    currentCallback->onFirstSideResult( currentCallback->userData );
+}
+
+static void onGlareTrampoline( MBBool hasGlare )
+{
+    currentCallback->onGlare( currentCallback->userData, hasGlare );
+}
+
+/* registers trampolines only for functions that user has set, so the SDK does not do work for events nobody handles */
+static void setupTrampolines( MBRecognitionCallback * trampolines, MBUserDataRecognitionCallback const * callback )
+{
+    recognitionCallbackDefaultInit( trampolines );
+
+    if ( callback->onDetectionStarted    != NULL ) trampolines->onDetectionStarted    = onDetectionStartedTrampoline;
+    if ( callback->onDetectionMidway     != NULL ) trampolines->onDetectionMidway     = onDetectionMidwayTrampoline;
+    if ( callback->onDetectedObject      != NULL ) trampolines->onDetectedObject      = onDetectedObjectTrampoline;
+    if ( callback->onDetectionFailed     != NULL ) trampolines->onDetectionFailed     = onDetectionFailedTrampoline;
+    if ( callback->onRecognitionStarted  != NULL ) trampolines->onRecognitionStarted  = onRecognitionStartedTrampoline;
+    if ( callback->onRecognitionFinished != NULL ) trampolines->onRecognitionFinished = onRecognitionFinishedTrampoline;
+    if ( callback->onFirstSideResult     != NULL ) trampolines->onFirstSideResult     = onFirstSideResultTrampoline;
+    if ( callback->onGlare               != NULL ) trampolines->onGlare               = onGlareTrampoline;
+
+    /* without any subscribed image type, the SDK must not be asked to produce images at all */
+    if ( callback->onShowImage != NULL && callback->showImageTypes != 0 )
+    {
+        trampolines->onShowImage = onShowImageTrampoline;
+    }
+}
+
+void userDataRecognitionCallbackDefaultInit( MBUserDataRecognitionCallback * callback )
+{
+    memset( callback, 0, sizeof( MBUserDataRecognitionCallback ) );
+    callback->showImageTypes = MB_SHOW_IMAGE_TYPE_ALL;
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithUserData
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback
+)
+{
+    MBRecognitionCallback                 trampolines;
+    MBUserDataRecognitionCallback const * previousCallback;
+    MBRecognizerResultState               resultState;
+
+    if ( callback == NULL )
+    {
+        return recognizerRunnerRecognizeFromImage( recognizerRunner, image, imageIsVideoFrame, NULL );
+    }
+
+    setupTrampolines( &trampolines, callback );
+
+    previousCallback = currentCallback;
+    currentCallback  = callback;
+
+    resultState = recognizerRunnerRecognizeFromImage( recognizerRunner, image, imageIsVideoFrame, &trampolines );
+
+    currentCallback = previousCallback;
+
+    return resultState;
+}
+
+MBRecognizerResultState recognizerRunnerRecognizeFromStringWithUserData
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    char                          const * string,
+    MBUserDataRecognitionCallback const * callback
+)
+{
+    MBRecognitionCallback                 trampolines;
+    MBUserDataRecognitionCallback const * previousCallback;
+    MBRecognizerResultState               resultState;
+
+    if ( callback == NULL )
+    {
+        return recognizerRunnerRecognizeFromString( recognizerRunner, string, NULL );
+    }
+
+    setupTrampolines( &trampolines, callback );
+
+    previousCallback = currentCallback;
+    currentCallback  = callback;
+
+    resultState = recognizerRunnerRecognizeFromString( recognizerRunner, string, &trampolines );
+
+    currentCallback = previousCallback;
+
+    return resultState;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file UserDataRecognitionCallback.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef USER_DATA_RECOGNITION_CALLBACK_H_
+#define USER_DATA_RECOGNITION_CALLBACK_H_
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+#include <Recognizer/Types.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Bit in MBUserDataRecognitionCallback::showImageTypes that subscribes to images of given MBShowImageType.
+ */
+#define MB_SHOW_IMAGE_TYPE_BIT( showType ) ( 1u << ( showType ) )
+
+/** @brief Value of MBUserDataRecognitionCallback::showImageTypes that subscribes to images of all types. */
+#define MB_SHOW_IMAGE_TYPE_ALL                                 \
+    ( MB_SHOW_IMAGE_TYPE_BIT( SHOW_IMAGE_TYPE_ORIGINAL ) |     \
+      MB_SHOW_IMAGE_TYPE_BIT( SHOW_IMAGE_TYPE_DEWARPED ) |     \
+      MB_SHOW_IMAGE_TYPE_BIT( SHOW_IMAGE_TYPE_SUCCESSFUL_SCAN ) )
+
+struct MBUserDataRecognitionCallback;
+
+/**
+ * @brief Typedef for MBUserDataRecognitionCallback structure.
+ */
+typedef struct MBUserDataRecognitionCallback MBUserDataRecognitionCallback;
+
+/**
+ * @memberof MBUserDataRecognitionCallback
+ * @brief Populate MBUserDataRecognitionCallback structure with default values (no user data, no callbacks and
+ * subscription to all image types).
+ * @return Nothing
+ */
+void userDataRecognitionCallbackDefaultInit( MBUserDataRecognitionCallback * );
+
+/**
+ * @struct MBUserDataRecognitionCallback
+ * @brief Counterpart of MBRecognitionCallback whose functions receive a user data pointer.
+ *
+ * Every function receives the userData given in this structure as its first parameter, so
+ * the callback can write directly into state of the request that is being processed,
+ * without any global lookup. Functions are called with the same semantics as their
+ * MBRecognitionCallback counterparts, and only if non-NULL function pointer is given.
+ *
+ * Use this structure with ::recognizerRunnerRecognizeFromImageWithUserData and
+ * ::recognizerRunnerRecognizeFromStringWithUserData.
+ */
+struct MBUserDataRecognitionCallback
+{
+    /** Pointer that will be given as first parameter to every callback function. */
+    void * userData;
+
+    /** @see MBRecognitionCallback::onDetectionStarted */
+    void (*onDetectionStarted)( void * userData );
+
+    /** @see MBRecognitionCallback::onDetectionMidway */
+    void (*onDetectionMidway)( void * userData, MBPoint const * points, size_t pointsSize );
+
+    /** @see MBRecognitionCallback::onDetectedObject */
+    MBBool (*onDetectedObject)( void * userData, MBPoint const * points, size_t pointsSize, MBDetectionStatus detectionStatus );
+
+    /** @see MBRecognitionCallback::onDetectionFailed */
+    void (*onDetectionFailed)( void * userData );
+
+    /** @see MBRecognitionCallback::onRecognitionStarted */
+    void (*onRecognitionStarted)( void * userData );
+
+    /** @see MBRecognitionCallback::onRecognitionFinished */
+    void (*onRecognitionFinished)( void * userData );
+
+    /**
+     * Bitmask of image types that should be delivered to onShowImage, composed of MB_SHOW_IMAGE_TYPE_BIT values.
+     * If onShowImage is NULL or this mask is 0, onShowImage is not registered with the SDK at all, so no
+     * images are produced for it. Images of types that are not in the mask are not delivered to onShowImage.
+     * By default, this is set to MB_SHOW_IMAGE_TYPE_ALL.
+     */
+    unsigned int showImageTypes;
+
+    /** @see MBRecognitionCallback::onShowImage */
+    void (*onShowImage)( void * userData, MBRecognizerImage const * image, MBShowImageType showType, char const * name );
+
+    /** @see MBRecognitionCallback::onFirstSideResult */
+    void (*onFirstSideResult)( void * userData );
+
+    /** @see MBRecognitionCallback::onGlare */
+    void (*onGlare)( void * userData, MBBool hasGlare );
+
+#ifdef __cplusplus
+    /**
+     * Default constructor for c++.
+     */
+    MBUserDataRecognitionCallback()
+    {
+        userDataRecognitionCallbackDefaultInit( this );
+    }
+#endif
+};
+
+/**
+ * @memberof MBRecognizerRunner
+ * @brief Performs recognition of given image, dispatching recognition events to callbacks that receive user data.
+ *
+ * This function behaves exactly as ::recognizerRunnerRecognizeFromImage. Only the callback functions that are set in
+ * given structure are registered with the recognizer runner. The user data is bound to the calling thread for the duration
+ * of the call, so multiple threads may use this function concurrently with different runners and different user data.
+ * Calls may also be nested, i.e. it is safe to start recognition with another runner from within a callback.
+ *
+ * @param recognizerRunner      object which performs recognition.
+ * @param image                 MBRecognizerImage object which holds image on which recognition will be performed.
+ * @param imageIsVideoFrame     @see ::recognizerRunnerRecognizeFromImage
+ * @param callback              Pointer to structure that contains user data and pointers to callback functions. If given NULL,
+ *                              no callback will be called.
+ *
+ * @return General state of the recognition run. @see ::recognizerRunnerRecognizeFromImage
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromImageWithUserData
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    MBRecognizerImage             const * image,
+    MBBool                                imageIsVideoFrame,
+    MBUserDataRecognitionCallback const * callback
+);
+
+/**
+ * @memberof MBRecognizerRunner
+ * @brief Performs recognition of given string, dispatching recognition events to callbacks that receive user data.
+ *
+ * This function behaves exactly as ::recognizerRunnerRecognizeFromString.
+ * @see ::recognizerRunnerRecognizeFromImageWithUserData for details about callback dispatching.
+ *
+ * @param recognizerRunner  object which performs recognition.
+ * @param string            String on which recognition will be performed.
+ * @param callback          Pointer to structure that contains user data and pointers to callback functions. If given NULL,
+ *                          no callback will be called.
+ *
+ * @return General state of the recognition run. @see ::recognizerRunnerRecognizeFromString
+ */
+MBRecognizerResultState recognizerRunnerRecognizeFromStringWithUserData
+(
+    MBRecognizerRunner                  * recognizerRunner,
+    char                          const * string,
+    MBUserDataRecognitionCallback const * callback
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
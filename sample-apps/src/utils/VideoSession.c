@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#include "VideoSession.h"
+#include "Platform.h"
+
+#include <stdlib.h>
+
+#define DEFAULT_LATENCY_SMOOTHING 0.1f
+
+struct MBVideoSession
+{
+    MBVideoSessionSettings settings;
+    uint64_t               periodNs;
+
+    MBPlatformMutex        mutex;
+    MBPlatformCondition    frameSubmitted;
+
+    /* newest frame that was not picked up yet, owned by the session */
+    MBRecognizerImage    * pendingFrame;
+    uint64_t               pendingSubmitTime;
+
+    /* start of the last recognition, for pacing to the target frame rate */
+    uint64_t               lastStartTime;
+    int                    closed;
+
+    MBVideoSessionStats    stats;
+};
+
+void videoSessionSettingsDefaultInit( MBVideoSessionSettings * settings )
+{
+    settings->targetFramesPerSecond = 0.f;
+    settings->latencySmoothing      = DEFAULT_LATENCY_SMOOTHING;
+}
+
+MBRecognizerErrorStatus videoSessionCreate( MBVideoSession ** session, MBVideoSessionSettings const * settings )
+{
+    MBVideoSession * newSession;
+
+    if ( session == NULL || ( settings != NULL && ( settings->targetFramesPerSecond < 0.f || settings->latencySmoothing <= 0.f || settings->latencySmoothing > 1.f ) ) )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+    *session = NULL;
+
+    newSession = ( MBVideoSession * ) calloc( 1, sizeof( MBVideoSession ) );
+    if ( newSession == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_MALLOC_FAIL;
+    }
+
+    if ( settings != NULL )
+    {
+        newSession->settings = *settings;
+    }
+    else
+    {
+        videoSessionSettingsDefaultInit( &newSession->settings );
+    }
+
+    if ( newSession->settings.targetFramesPerSecond > 0.f )
+    {
+        newSession->periodNs = ( uint64_t ) ( 1e9 / newSession->settings.targetFramesPerSecond );
+    }
+
+    platformMutexInit( &newSession->mutex );
+    platformConditionInit( &newSession->frameSubmitted );
+
+    *session = newSession;
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus videoSessionSubmitFrame( MBVideoSession * session, MBRecognizerImage const * frame )
+{
+    MBRecognizerImage     * copy;
+    MBRecognizerImage     * dropped;
+    MBRecognizerErrorStatus status;
+
+    if ( session == NULL || frame == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* copy outside of the lock, so that the recognition thread is never blocked by it */
+    status = recognizerImageCreateCopyFromImage( &copy, frame );
+    if ( status != MB_RECOGNIZER_ERROR_STATUS_SUCCESS )
+    {
+        return status;
+    }
+
+    platformMutexLock( &session->mutex );
+
+    ++session->stats.submittedFrames;
+    if ( session->closed )
+    {
+        dropped = copy;
+    }
+    else
+    {
+        dropped                    = session->pendingFrame;
+        session->pendingFrame      = copy;
+        session->pendingSubmitTime = platformMonotonicNanoseconds();
+        if ( dropped != NULL )
+        {
+            ++session->stats.droppedFrames;
+        }
+        platformConditionBroadcast( &session->frameSubmitted );
+    }
+
+    platformMutexUnlock( &session->mutex );
+
+    if ( dropped != NULL )
+    {
+        recognizerImageDelete( &dropped );
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+static uint64_t smooth( uint64_t average, uint64_t sample, float weight )
+{
+    if ( average == 0 )
+    {
+        return sample;
+    }
+    return ( uint64_t ) ( ( double ) average + weight * ( ( double ) sample - ( double ) average ) );
+}
+
+MBRecognizerErrorStatus videoSessionRecognizeNewestFrame
+(
+    MBVideoSession                      * session,
+    MBRecognizerRunner                  * recognizerRunner,
+    MBUserDataRecognitionCallback const * callback,
+    uint32_t                              timeoutMs,
+    MBRecognizerResultState             * state
+)
+{
+    MBRecognizerImage * frame;
+    uint64_t            submitTime;
+    uint64_t            startTime;
+    uint64_t            endTime;
+    uint64_t            deadline;
+    uint64_t            now;
+
+    if ( session == NULL || recognizerRunner == NULL || state == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    now      = platformMonotonicNanoseconds();
+    deadline = now + ( uint64_t ) timeoutMs * 1000000u;
+
+    frame      = NULL;
+    submitTime = 0;
+
+    platformMutexLock( &session->mutex );
+
+    while ( !session->closed )
+    {
+        uint64_t wakeTime = deadline;
+
+        if ( session->pendingFrame != NULL )
+        {
+            /* frames that arrive before the next slot of the target frame rate replace each other */
+            uint64_t nextStartTime = session->lastStartTime + session->periodNs;
+
+            if ( session->lastStartTime == 0 || now >= nextStartTime )
+            {
+                frame                  = session->pendingFrame;
+                submitTime             = session->pendingSubmitTime;
+                session->pendingFrame  = NULL;
+                session->lastStartTime = now;
+                break;
+            }
+            if ( nextStartTime < wakeTime )
+            {
+                wakeTime = nextStartTime;
+            }
+        }
+
+        if ( now >= deadline )
+        {
+            break;
+        }
+
+        platformConditionWait( &session->frameSubmitted, &session->mutex, wakeTime - now );
+        now = platformMonotonicNanoseconds();
+    }
+
+    platformMutexUnlock( &session->mutex );
+
+    if ( frame == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_FAIL;
+    }
+
+    startTime = now;
+    *state    = recognizerRunnerRecognizeFromImageWithUserData( recognizerRunner, frame, MB_TRUE, callback );
+    endTime   = platformMonotonicNanoseconds();
+
+    recognizerImageDelete( &frame );
+
+    platformMutexLock( &session->mutex );
+
+    ++session->stats.recognizedFrames;
+    session->stats.recognitionLatencyNs = smooth( session->stats.recognitionLatencyNs, endTime - startTime, session->settings.latencySmoothing );
+    session->stats.endToEndLatencyNs    = smooth( session->stats.endToEndLatencyNs,    endTime - submitTime, session->settings.latencySmoothing );
+
+    platformMutexUnlock( &session->mutex );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus videoSessionClose( MBVideoSession * session )
+{
+    MBRecognizerImage * dropped;
+
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    platformMutexLock( &session->mutex );
+
+    session->closed       = 1;
+    dropped               = session->pendingFrame;
+    session->pendingFrame = NULL;
+    platformConditionBroadcast( &session->frameSubmitted );
+
+    platformMutexUnlock( &session->mutex );
+
+    if ( dropped != NULL )
+    {
+        recognizerImageDelete( &dropped );
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus videoSessionGetStats( MBVideoSessionStats * stats, MBVideoSession * session )
+{
+    if ( stats == NULL || session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    platformMutexLock( &session->mutex );
+    *stats = session->stats;
+    platformMutexUnlock( &session->mutex );
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
+
+MBRecognizerErrorStatus videoSessionDelete( MBVideoSession ** session )
+{
+    if ( session == NULL )
+    {
+        return MB_RECOGNIZER_ERROR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if ( *session != NULL )
+    {
+        if ( ( *session )->pendingFrame != NULL )
+        {
+            recognizerImageDelete( &( *session )->pendingFrame );
+        }
+        platformConditionDestroy( &( *session )->frameSubmitted );
+        platformMutexDestroy( &( *session )->mutex );
+        free( *session );
+        *session = NULL;
+    }
+
+    return MB_RECOGNIZER_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file VideoSession.h
+ *
+ * Copyright (c) Microblink Ltd. All rights reserved.
+ *
+ * ANY UNAUTHORIZED USE OR SALE, DUPLICATION, OR DISTRIBUTION
+ * OF THIS PROGRAM OR ANY OF ITS PARTS, IN SOURCE OR BINARY FORMS,
+ * WITH OR WITHOUT MODIFICATION, WITH THE PURPOSE OF ACQUIRING
+ * UNLAWFUL MATERIAL OR ANY OTHER BENEFIT IS PROHIBITED!
+ * THIS PROGRAM IS PROTECTED BY COPYRIGHT LAWS AND YOU MAY NOT
+ * REVERSE ENGINEER, DECOMPILE, OR DISASSEMBLE IT.
+ */
+
+#ifndef VIDEO_SESSION_H_
+#define VIDEO_SESSION_H_
+
+#include "UserDataRecognitionCallback.h"
+
+#include <Recognizer/Recognizer.h>
+#include <Recognizer/RecognizerError.h>
+#include <Recognizer/RecognizerImage.h>
+#include <Recognizer/RecognizerRunner.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct MBVideoSessionSettings
+ * @brief Settings of MBVideoSession.
+ */
+struct MBVideoSessionSettings
+{
+    /**
+     * Maximum number of frames recognized per second. Frames that arrive in between are coalesced, i.e. only the newest
+     * of them is recognized. 0 means that frames are recognized as fast as the CPU allows. By default, this is set to 0.
+     */
+    float targetFramesPerSecond;
+
+    /**
+     * Weight of the newest measurement in the moving averages of latency, from 0 to 1. Larger values follow changes of
+     * the CPU load faster, but are noisier. By default, this is set to 0.1.
+     */
+    float latencySmoothing;
+};
+
+/**
+ * @brief Typedef for MBVideoSessionSettings structure.
+ */
+typedef struct MBVideoSessionSettings MBVideoSessionSettings;
+
+/**
+ * @memberof MBVideoSessionSettings
+ * @brief Populate MBVideoSessionSettings structure with default values.
+ * @param settings Settings that will be initialized.
+ */
+void videoSessionSettingsDefaultInit( MBVideoSessionSettings * settings );
+
+/**
+ * @struct MBVideoSessionStats
+ * @brief Counters and latency measurements of MBVideoSession.
+ */
+struct MBVideoSessionStats
+{
+    /** Number of frames submitted by the camera. */
+    size_t submittedFrames;
+
+    /** Number of frames that were recognized. */
+    size_t recognizedFrames;
+
+    /** Number of frames replaced by a newer frame before they could be recognized. */
+    size_t droppedFrames;
+
+    /** Moving average of the time spent in recognition of a single frame, in nanoseconds. */
+    uint64_t recognitionLatencyNs;
+
+    /** Moving average of the time from submission of a frame until the end of its recognition, in nanoseconds. */
+    uint64_t endToEndLatencyNs;
+};
+
+/**
+ * @brief Typedef for MBVideoSessionStats structure.
+ */
+typedef struct MBVideoSessionStats MBVideoSessionStats;
+
+/**
+ * @struct MBVideoSession
+ * @brief Connects the camera thread with the recognition thread through a slot that holds only the newest frame.
+ *
+ * The camera thread submits every frame with ::videoSessionSubmitFrame, which never blocks on recognition. A frame that
+ * was not picked up before the next one arrives is dropped, so when the CPU cannot keep up, the recognition thread
+ * always continues with the freshest frame and the end-to-end latency stays bounded by about two recognition times,
+ * instead of growing with a backlog of stale frames. Target frame rate further limits the CPU spent on recognition.
+ *
+ * Session can be used by one camera thread and one recognition thread at the same time.
+ */
+struct MBVideoSession;
+
+/**
+ * @brief Typedef for MBVideoSession structure.
+ */
+typedef struct MBVideoSession MBVideoSession;
+
+/**
+ * @memberof MBVideoSession
+ * @brief Allocates and initializes new MBVideoSession object.
+ * @param session   Pointer to pointer referencing the created object.
+ * @param settings  Settings of the session, or NULL for default settings.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus videoSessionCreate( MBVideoSession ** session, MBVideoSessionSettings const * settings );
+
+/**
+ * @memberof MBVideoSession
+ * @brief Stores copy of the frame as the newest frame, dropping the previous one if it was not recognized yet.
+ * @param session   Session of interest.
+ * @param frame     Frame from the camera. It may be released as soon as the function returns.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus videoSessionSubmitFrame( MBVideoSession * session, MBRecognizerImage const * frame );
+
+/**
+ * @memberof MBVideoSession
+ * @brief Waits for the newest frame and the next slot of the target frame rate, then recognizes the frame as video.
+ * @param session           Session of interest.
+ * @param recognizerRunner  Recognizer runner that will perform recognition.
+ * @param callback          Callbacks of the user, or NULL.
+ * @param timeoutMs         Maximum time to wait for a frame, in milliseconds.
+ * @param state             Receives state of the recognition result.
+ * @return MB_RECOGNIZER_ERROR_STATUS_SUCCESS if a frame was recognized, or MB_RECOGNIZER_ERROR_STATUS_FAIL if no frame
+ *         could be recognized before the timeout expired or the session was closed.
+ */
+MBRecognizerErrorStatus videoSessionRecognizeNewestFrame
+(
+    MBVideoSession                      * session,
+    MBRecognizerRunner                  * recognizerRunner,
+    MBUserDataRecognitionCallback const * callback,
+    uint32_t                              timeoutMs,
+    MBRecognizerResultState             * state
+);
+
+/**
+ * @memberof MBVideoSession
+ * @brief Closes the session, waking the recognition thread. Further frames are ignored.
+ * @param session   Session of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus videoSessionClose( MBVideoSession * session );
+
+/**
+ * @memberof MBVideoSession
+ * @brief Obtains counters and latency measurements of the session.
+ * @param stats     Structure that will receive the counters.
+ * @param session   Session of interest.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus videoSessionGetStats( MBVideoSessionStats * stats, MBVideoSession * session );
+
+/**
+ * @memberof MBVideoSession
+ * @brief Destroys the given MBVideoSession and sets pointer to it to NULL. Neither thread may use the session anymore.
+ * @param session   Pointer to pointer to MBVideoSession that needs to be destroyed.
+ * @return status of the operation.
+ */
+MBRecognizerErrorStatus videoSessionDelete( MBVideoSession ** session );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif